@@ -2,6 +2,8 @@ import QtQuick 2.10
 import QtQuick.Window 2.10
 import QtQuick.Controls 2.12
 import QtQuick.Layouts 1.12
+import QtQml 2.12
+import QtQml.Models 2.12
 import Kaj.Dock 1.0
 
 ApplicationWindow {
@@ -12,18 +14,125 @@ ApplicationWindow {
 
     menuBar: MenuBar {
         Menu {
+            id: windowsMenu
             title: "Windows"
-            Repeater {
-                model: dockArea.dockWidgets
-                MenuItem {
-                    text: modelData.title
+            Instantiator {
+                model: dockArea.layoutModel
+                delegate: Menu {
+                    id: areaMenu
+                    property int areaRow: index
+                    title: model.title
+                    Instantiator {
+                        model: DelegateModel {
+                            model: dockArea.layoutModel
+                            rootIndex: dockArea.layoutModel.index(areaMenu.areaRow, 0)
+                            delegate: MenuItem {
+                                text: model.title
+                                checkable: true
+                                checked: model.visibility !== DockWidget.Closed
+                                onToggled: {
+                                    if (checked)
+                                        model.dockWidget.open();
+                                    else
+                                        model.dockWidget.close();
+                                }
+                            }
+                        }
+                        onObjectAdded: (index, object) => areaMenu.insertItem(index, object)
+                        onObjectRemoved: (index, object) => areaMenu.removeItem(object)
+                    }
+                }
+                onObjectAdded: (index, object) => windowsMenu.insertMenu(index, object)
+                onObjectRemoved: (index, object) => windowsMenu.removeMenu(object)
+            }
+        }
+        Menu {
+            id: perspectivesMenu
+            title: "Perspectives"
+            Instantiator {
+                model: dockArea.perspectives
+                delegate: MenuItem {
+                    text: modelData
                     checkable: true
-                    checked: modelData.visibility !== DockWidget.Closed
-                    onCheckedChanged: {
-                        if (checked)
-                            modelData.open();
-                        else
-                            modelData.close();
+                    checked: dockArea.currentPerspective === modelData
+                    onTriggered: dockArea.switchPerspective(modelData)
+                }
+                onObjectAdded: (index, object) => perspectivesMenu.insertItem(index, object)
+                onObjectRemoved: (index, object) => perspectivesMenu.removeItem(object)
+            }
+            MenuSeparator {}
+            MenuItem {
+                text: "Save as \"edit\""
+                onTriggered: dockArea.savePerspective("edit")
+            }
+            MenuItem {
+                text: "Save as \"debug\""
+                onTriggered: dockArea.savePerspective("debug")
+            }
+        }
+    }
+
+    Shortcut {
+        sequence: "Ctrl+Tab"
+        onActivated: dockArea.activateDockWidget(dockArea.recentDockWidget(1))
+    }
+
+    Shortcut {
+        sequence: StandardKey.Undo
+        enabled: dockArea.canUndo
+        onActivated: dockArea.undo()
+    }
+
+    Shortcut {
+        sequence: StandardKey.Redo
+        enabled: dockArea.canRedo
+        onActivated: dockArea.redo()
+    }
+
+    Shortcut {
+        sequence: "Ctrl+P"
+        onActivated: quickOpen.open()
+    }
+
+    Popup {
+        id: quickOpen
+        x: (parent.width - width) / 2
+        y: 20
+        width: 300
+        height: 250
+        focus: true
+        onOpened: {
+            quickOpenField.text = "";
+            quickOpenField.forceActiveFocus();
+        }
+
+        ColumnLayout {
+            anchors.fill: parent
+            TextField {
+                id: quickOpenField
+                Layout.fillWidth: true
+                placeholderText: "Go to dock..."
+                onTextChanged: dockArea.quickOpenModel.query = text
+                onAccepted: {
+                    dockArea.quickOpenModel.activate(quickOpenList.currentIndex);
+                    quickOpen.close();
+                }
+                Keys.onDownPressed: quickOpenList.incrementCurrentIndex()
+                Keys.onUpPressed: quickOpenList.decrementCurrentIndex()
+            }
+            ListView {
+                id: quickOpenList
+                Layout.fillWidth: true
+                Layout.fillHeight: true
+                clip: true
+                model: dockArea.quickOpenModel
+                delegate: ItemDelegate {
+                    width: ListView.view.width
+                    text: model.title
+                    highlighted: ListView.isCurrentItem
+                    onClicked: {
+                        dockArea.quickOpenModel.activate(index);
+                        quickOpen.close();
                     }
                 }
             }
@@ -34,6 +143,7 @@ ApplicationWindow {
         id: dockArea
         anchors.fill: parent
         enableStateStoring: false
+        defaultLayout: "basic"
 
         DockArea {
             id: centerDockGroup
@@ -119,7 +229,10 @@ ApplicationWindow {
         DockWidget {
             area: Dock.Center
             title: "Settings"
-            contentItem: CornerOwnerSettings { dockContainer: dockArea }
+            contentLoading: DockWidget.PreloadWhenIdle
+            contentComponent: Component {
+                CornerOwnerSettings { dockContainer: dockArea }
+            }
         }
         DockWidget {
             area: Dock.Center
@@ -1,6 +1,58 @@
 #ifndef DOCK_P_H
 #define DOCK_P_H
 
-namespace Dock {}
+#include <QHash>
+
+#include <list>
+
+namespace Dock {
+
+// Most recently used first; touch, remove and lookup are O(1)
+template <class T> class RecencyList {
+  std::list<T> _items;
+  QHash<T, typename std::list<T>::iterator> _index;
+
+public:
+  using const_iterator = typename std::list<T>::const_iterator;
+  using const_reverse_iterator = typename std::list<T>::const_reverse_iterator;
+
+  void touch(const T &item) {
+    auto i = _index.find(item);
+    if (i != _index.end()) {
+      _items.splice(_items.begin(), _items, i.value());
+      return;
+    }
+    _items.push_front(item);
+    _index.insert(item, _items.begin());
+  }
+
+  bool remove(const T &item) {
+    auto i = _index.find(item);
+    if (i == _index.end())
+      return false;
+    _items.erase(i.value());
+    _index.erase(i);
+    return true;
+  }
+
+  bool contains(const T &item) const { return _index.contains(item); }
+  int size() const { return static_cast<int>(_index.size()); }
+  bool isEmpty() const { return _index.isEmpty(); }
+
+  T first() const { return _items.empty() ? T() : _items.front(); }
+  T last() const { return _items.empty() ? T() : _items.back(); }
+
+  void clear() {
+    _items.clear();
+    _index.clear();
+  }
+
+  const_iterator begin() const { return _items.cbegin(); }
+  const_iterator end() const { return _items.cend(); }
+  const_reverse_iterator rbegin() const { return _items.crbegin(); }
+  const_reverse_iterator rend() const { return _items.crend(); }
+};
+
+} // namespace Dock
 
 #endif // DOCK_P_H
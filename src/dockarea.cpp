@@ -2,24 +2,43 @@
 
 #include "debugrect.h"
 #include "dockarea_p.h"
+#include "dockcontainer.h"
+#include "dockcontainer_p.h"
+#include "dockgriplayer.h"
 #include "dockgroupresizehandler.h"
 #include "style/abstractstyle.h"
 #include "docktabbar.h"
 #include "dockwidget.h"
+#include "dockwidgetattached.h"
 
-#include <QCursor>
 #include <QDebug>
 #include <QPainter>
+#include <QQuickWindow>
 
 DockAreaPrivate::DockAreaPrivate(DockArea *parent)
-    : q_ptr(parent), currentIndex{-1}, mousePressed{false},
-      area(Dock::Float), enableResizing{true}, tabBar{nullptr}, tabBarItem{nullptr}, displayType{Dock::SplitView},
-      minimumSize(80), maximumSize(400), tabPosition{Qt::TopEdge} {}
+    : q_ptr(parent), currentIndex{-1}, area(Dock::Float), enableResizing{true}, tabBar{nullptr}, tabBarItem{nullptr}, displayType{Dock::SplitView},
+      autoHide{false}, expanded{false}, expandedByHover{false}, relayoutPending{false}, minimumSize(80), maximumSize(400), tabPosition{Qt::TopEdge} {}
 
 void DockAreaPrivate::relayout() {
+  Q_Q(DockArea);
+
+  // the container relayouts every pending area when its batch ends
+  auto container = qobject_cast<DockContainer *>(q->parentItem());
+  if (container && container->d_func()->batchDepth) {
+    relayoutPending = true;
+    return;
+  }
+
+  for (auto &dw : dockWidgets)
+    if (dw->isMaximized()) {
+      relayoutPending = true;
+      return;
+    }
+  relayoutPending = false;
+
   updateUsableArea();
 
-  if (tabBarItem && displayType == Dock::TabbedView)
+  if (tabBarItem && effectiveDisplayType() == Dock::TabbedView)
     arrangeTabBar();
 
   reorderHandles();
@@ -58,22 +77,33 @@ void DockAreaPrivate::arrangeTabBar() {
   tabBarItem->setWidth(tabBarWidth);
 }
 
+DockGripLayer *DockAreaPrivate::gripLayer() const {
+  Q_Q(const DockArea);
+  auto container = qobject_cast<DockContainer *>(q->parentItem());
+  return container ? container->gripLayer() : nullptr;
+}
+
 DockAreaResizeHandler *DockAreaPrivate::createHandlers() {
   Q_Q(DockArea);
 
+  auto layer = gripLayer();
+  if (!layer)
+    return nullptr;
+
+  // handlers live in the container's grip layer, so they use container coordinates
   DockAreaResizeHandler *h{nullptr};
   switch (area) {
   case Dock::Left:
   case Dock::Right:
-    h = new DockAreaResizeHandler(Qt::Horizontal, q);
-    h->setX(0);
+    h = layer->acquireHandler(Qt::Horizontal, q);
+    h->setX(q->x());
     h->setWidth(q->width());
     break;
 
   case Dock::Top:
   case Dock::Bottom:
-    h = new DockAreaResizeHandler(Qt::Vertical, q);
-    h->setY(0);
+    h = layer->acquireHandler(Qt::Vertical, q);
+    h->setY(q->y());
     h->setHeight(q->height());
     break;
 
@@ -98,32 +128,132 @@ bool DockAreaPrivate::isVertical() const {
   return area == Dock::Right || area == Dock::Left;
 }
 
-bool DockAreaPrivate::acceptResizeEvent(const QPointF &point) {
+bool DockAreaPrivate::isCollapsed() const {
+  return autoHide && !expanded;
+}
+
+Dock::DockWidgetDisplayType DockAreaPrivate::effectiveDisplayType() const {
+  // an auto-hide panel always shows its widgets as tabs, the strip is the tab bar
+  return autoHide ? Dock::TabbedView : displayType;
+}
+
+Qt::Edge DockAreaPrivate::effectiveTabPosition() const {
+  // the strip of a side panel is narrow, its tabs have to run along it
+  if (autoHide && area == Dock::Left)
+    return Qt::LeftEdge;
+  if (autoHide && area == Dock::Right)
+    return Qt::RightEdge;
+  return tabPosition;
+}
+
+void DockAreaPrivate::setHoverTracking(bool hoverTracking) {
   Q_Q(DockArea);
+  // the docks laid over the panel take the hover events from it, so the
+  // pointer leaving the panel shows up on them as well
+  q->setAcceptHoverEvents(hoverTracking);
+  for (auto &dw : dockWidgets)
+    dw->setAcceptHoverEvents(hoverTracking || dw->area() == Dock::Detached);
+}
 
-  if (!enableResizing)
-    return false;
+void DockAreaPrivate::pointerLeft(const QPointF &scenePos) {
+  Q_Q(DockArea);
+  if (!expanded || !expandedByHover)
+    return;
 
-  switch (area) {
-  case Dock::Right:
-    return point.x() < dockStyle->resizeHandleSize();
+  // once a dock of the panel has focus it stays open until a press outside
+  auto window = q->window();
+  auto focused = window ? DockWidgetAttached::findOwner(window->activeFocusItem()) : nullptr;
+  if (focused && focused->dockArea() == q) {
+    expandedByHover = false;
+    setHoverTracking(false);
+    return;
+  }
+
+  // moving between the panel and its docks is not leaving it
+  if (!q->contains(q->mapFromScene(scenePos)))
+    q->setExpanded(false);
+}
+
+void DockAreaPrivate::activateDockWidget(int index) {
+  Q_Q(DockArea);
+  // a clicked tab is a use of its dock just like focus moving into it, so
+  // it goes to the front of the container's recently used list
+  auto container = qobject_cast<DockContainer *>(q->parentItem());
+  auto dw = dockWidgets.value(index);
+  if (container && dw)
+    container->setActiveDockWidget(dw);
+}
+
+void DockAreaPrivate::applyTabPosition() {
+  if (!tabBarItem)
+    return;
+
+  auto edge = effectiveTabPosition();
+  switch (edge) {
+  case Qt::TopEdge:
+  case Qt::BottomEdge:
+    tabBarItem->setRotation(0);
     break;
 
-  case Dock::Left:
-    return point.x() > q->width() - dockStyle->resizeHandleSize();
+  case Qt::LeftEdge:
+    tabBarItem->setRotation(-90);
     break;
 
-  case Dock::Bottom:
-    return point.y() < dockStyle->resizeHandleSize();
+  case Qt::RightEdge:
+    tabBarItem->setRotation(90);
+    break;
+  }
+
+  if (tabBar)
+    tabBar->setEdge(edge);
+}
+
+QRectF DockAreaPrivate::overlayRect(const QRectF &rect) const {
+  switch (area) {
+  case Dock::Left:
+    return QRectF(rect.left(), rect.top(), panelSize, rect.height());
+
+  case Dock::Right:
+    return QRectF(rect.right() - panelSize, rect.top(), panelSize, rect.height());
 
   case Dock::Top:
-    return point.y() > q->height() - dockStyle->resizeHandleSize();
+    return QRectF(rect.left(), rect.top(), rect.width(), panelSize);
+
+  case Dock::Bottom:
+    return QRectF(rect.left(), rect.bottom() - panelSize, rect.width(), panelSize);
 
   default:
-    return false;
+    return rect;
   }
 }
 
+QRectF DockAreaPrivate::dropRect(const QRectF &rect, int index) const {
+  // an expanded auto-hide panel covers more than the strip it reserves
+  auto rc = autoHide ? overlayRect(rect) : rect;
+  auto usable = usableAreaFor(rc.size(), nullptr, nullptr);
+
+  if (effectiveDisplayType() != Dock::SplitView || !(isVertical() || isHorizontal()))
+    return usable.translated(rc.topLeft());
+
+  // scratch copy of the split with the new widget in place, the way addDockWidget
+  // followed by moveDockWidget would leave it
+  auto sizes = itemSizes;
+  sizes.resize(dockWidgets.count());
+  if (index < 0 || index > sizes.count())
+    index = sizes.count();
+  sizes.insert(index, 0);
+  normalizeSizes(&sizes);
+
+  return splitRects(rc, usable, sizes).at(index);
+}
+
+void DockAreaPrivate::applyLayoutRect() {
+  Q_Q(DockArea);
+  auto rc = (autoHide && expanded) ? overlayRect(layoutRect) : layoutRect;
+  q->setPosition(rc.topLeft());
+  q->setSize(rc.size());
+}
+
 void DockAreaPrivate::fitItem(QQuickItem *item) {
   Q_Q(DockArea);
 
@@ -162,49 +292,50 @@ void DockAreaPrivate::fitItem(QQuickItem *item) {
   }
 }
 
-void DockAreaPrivate::reorderItems() {
-  Q_Q(DockArea);
-  int ss;
+QList<QRectF> DockAreaPrivate::splitRects(const QRectF &rect, const QRectF &usable, const QList<qreal> &sizes) const {
+  QList<QRectF> rects;
+  if (!isVertical() && !isHorizontal())
+    return rects;
 
-  qreal freeSize;
+  rects.reserve(sizes.count());
+  auto handleSize = dockStyle->resizeHandleSize();
+  int ss = isVertical() ? rect.y() : rect.x();
+  qreal freeSize = (isVertical() ? rect.height() : rect.width()) - handleSize * (sizes.count() - 1);
 
-  if (isVertical()) {
-    ss = q->y();
-    freeSize = (q->height() - (dockStyle->resizeHandleSize() * (dockWidgets.count() - 1)));
+  for (auto size : sizes) {
+    if (isVertical()) {
+      rects.append(QRectF(rect.x() + usable.x(), ss, usable.width(), size * freeSize));
+      ss += rects.last().height() + handleSize;
+    } else {
+      rects.append(QRectF(ss, rect.y() + usable.y(), size * freeSize, usable.height()));
+      ss += rects.last().width() + handleSize;
+    }
   }
+  return rects;
+}
+
+void DockAreaPrivate::reorderItems() {
+  Q_Q(DockArea);
+
+  QList<QRectF> rects;
+  if (effectiveDisplayType() == Dock::SplitView)
+    rects = splitRects(QRectF(q->position(), q->size()), usableArea, itemSizes);
 
-  if (isHorizontal()) {
-    ss = q->x();
-    freeSize = (q->width() - (dockStyle->resizeHandleSize() * (dockWidgets.count() - 1)));
-  }
-  QList<qreal> sl;
   for (int i = 0; i < dockWidgets.count(); i++) {
     auto dw = dockWidgets.at(i);
 
-    switch (displayType) {
+    switch (effectiveDisplayType()) {
     case Dock::SplitView:
-      if (isVertical()) {
-        dw->setHeight(itemSizes.at(i) * freeSize);
-        dw->setY(ss);
-        dw->setX(q->x() + usableArea.x());
-        dw->setWidth(usableArea.width());
-        ss += dw->height() + dockStyle->resizeHandleSize();
-        sl.append(dw->height());
-      }
-      if (isHorizontal()) {
-        dw->setWidth(itemSizes.at(i) * freeSize);
-        dw->setX(ss);
-        dw->setY(q->y() + usableArea.y());
-        dw->setHeight(usableArea.height());
-        ss += dw->width() + dockStyle->resizeHandleSize();
-        sl.append(dw->width());
+      if (i < rects.count()) {
+        dw->setPosition(rects.at(i).topLeft());
+        dw->setSize(rects.at(i).size());
       }
-      if (i < dockWidgets.count() - 1) {
+      if (i < rects.count() - 1 && i < handlers.count()) {
         if (isVertical())
-          handlers.at(i)->setY(ss - q->y() - dockStyle->resizeHandleSize());
+          handlers.at(i)->setY(rects.at(i + 1).y() - dockStyle->resizeHandleSize());
 
         if (isHorizontal())
-          handlers.at(i)->setX(ss - q->x() - dockStyle->resizeHandleSize());
+          handlers.at(i)->setX(rects.at(i + 1).x() - dockStyle->resizeHandleSize());
       }
       dw->setVisibility(DockWidget::Openned);
       break;
@@ -213,8 +344,8 @@ void DockAreaPrivate::reorderItems() {
     case Dock::StackedView:
       dw->setPosition(q->position() + usableArea.topLeft());
       dw->setSize(usableArea.size());
-      dw->setVisible(i == currentIndex);
-      dw->setVisibility(i == currentIndex ? DockWidget::Openned : DockWidget::Hidden);
+      dw->setVisible(i == currentIndex && !isCollapsed());
+      dw->setVisibility(i == currentIndex && !isCollapsed() ? DockWidget::Openned : DockWidget::Hidden);
       break;
 
     case Dock::Hidden:
@@ -228,24 +359,27 @@ void DockAreaPrivate::reorderHandles() {
 
   int index{0};
   for (auto &h : handlers) {
-    if (displayType == Dock::SplitView) {
+    h->setVisible(effectiveDisplayType() == Dock::SplitView && q->isVisible());
+    if (effectiveDisplayType() == Dock::SplitView) {
       h->setIndex(index++);
       if (isVertical()) {
-        h->setX(0);
+        h->setX(q->x());
         h->setWidth(q->width());
       }
       if (isHorizontal()) {
-        h->setY(0);
+        h->setY(q->y());
         h->setHeight(q->height());
       }
-    } else {
-      h->setVisible(false);
     }
   }
 }
 
+void DockAreaPrivate::reindexDockWidgets(int from) {
+  for (int i = qMax(0, from); i < dockWidgets.size(); ++i)
+    dockWidgetIndexes[dockWidgets.at(i)] = i;
+}
+
 void DockAreaPrivate::normalizeItemSizes() {
-  qreal sum{0};
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
   itemSizes.resize(dockWidgets.count());
 #else
@@ -260,89 +394,102 @@ void DockAreaPrivate::normalizeItemSizes() {
         itemSizes.removeLast();
   }
 #endif
+  normalizeSizes(&itemSizes);
+}
 
-  for (auto i = 0; i != itemSizes.count(); ++i) {
-    if (qFuzzyCompare(0, itemSizes.at(i)))
-      itemSizes[i] = 1. / itemSizes.count();
-    sum += itemSizes.at(i);
+void DockAreaPrivate::normalizeSizes(QList<qreal> *sizes) {
+  qreal sum{0};
+  for (auto i = 0; i != sizes->count(); ++i) {
+    if (qFuzzyCompare(0, sizes->at(i)))
+      (*sizes)[i] = 1. / sizes->count();
+    sum += sizes->at(i);
   }
 
-  for (auto i = 0; i != itemSizes.count(); ++i) {
-    if (i == itemSizes.count())
-      itemSizes[i] = 1 - sum;
+  for (auto i = 0; i != sizes->count(); ++i) {
+    if (i == sizes->count())
+      (*sizes)[i] = 1 - sum;
     else
-      itemSizes[i] = itemSizes.at(i) / sum;
+      (*sizes)[i] = sizes->at(i) / sum;
   }
 }
 
 void DockAreaPrivate::updateTabbedView() {
   for (int i = 0; i < dockWidgets.count(); ++i)
-    dockWidgets.at(i)->setVisible(i == currentIndex);
+    dockWidgets.at(i)->setVisible(i == currentIndex && !isCollapsed());
   if (tabBar)
     tabBar->setCurrentIndex(currentIndex);
 }
 
 QRectF DockAreaPrivate::updateUsableArea() {
   Q_Q(DockArea);
-  usableArea = QRectF(1, 1, q->width() - 2, q->height() - 2);
+  usableArea = usableAreaFor(q->size(), &tabBarPosition, &tabBarWidth);
+  return usableArea;
+}
+
+QRectF DockAreaPrivate::usableAreaFor(const QSizeF &size, QPointF *tabBarPosition, qreal *tabBarWidth) const {
+  QRectF rc(1, 1, size.width() - 2, size.height() - 2);
+  QPointF barPosition;
+  qreal barWidth;
 
   if (enableResizing)
     switch (area) {
     case Dock::Right:
-      usableArea.setLeft(dockStyle->resizeHandleSize() + 1);
+      rc.setLeft(dockStyle->resizeHandleSize() + 1);
       break;
 
     case Dock::Left:
-      usableArea.setRight(usableArea.right() - dockStyle->resizeHandleSize());
+      rc.setRight(rc.right() - dockStyle->resizeHandleSize());
       break;
 
     case Dock::Top:
-      usableArea.setBottom(usableArea.bottom() - dockStyle->resizeHandleSize());
+      rc.setBottom(rc.bottom() - dockStyle->resizeHandleSize());
       break;
     case Dock::Bottom:
-      usableArea.setTop(dockStyle->resizeHandleSize() + 1);
+      rc.setTop(dockStyle->resizeHandleSize() + 1);
       break;
 
     default:
       break;
     }
-  tabBarPosition.setX(usableArea.x() - 1);
-  tabBarPosition.setY(usableArea.y() - 1);
-  tabBarWidth = usableArea.width();
-  if (tabBarItem && displayType == Dock::TabbedView) {
-    switch (tabPosition) {
+  barPosition.setX(rc.x() - 1);
+  barPosition.setY(rc.y() - 1);
+  barWidth = rc.width();
+  if (tabBarItem && effectiveDisplayType() == Dock::TabbedView) {
+    switch (effectiveTabPosition()) {
     case Qt::TopEdge:
-      usableArea.setTop(usableArea.top() + tabBarItem->height());
+      rc.setTop(rc.top() + tabBarItem->height());
       break;
     case Qt::RightEdge:
-      tabBarPosition = QPointF(q->width(), 0);
-      tabBarWidth = usableArea.height();
-      usableArea.setRight(usableArea.right() - tabBarItem->height());
+      barPosition = QPointF(size.width(), 0);
+      barWidth = rc.height();
+      rc.setRight(rc.right() - tabBarItem->height());
       break;
     case Qt::LeftEdge:
-      tabBarPosition = usableArea.bottomLeft();
-      // QPointF(0, q->height());
-      tabBarWidth = usableArea.height() + 1;
-      usableArea.setLeft(usableArea.left() + tabBarItem->height());
+      barPosition = rc.bottomLeft();
+      // QPointF(0, size.height());
+      barWidth = rc.height() + 1;
+      rc.setLeft(rc.left() + tabBarItem->height());
       break;
     case Qt::BottomEdge:
-      tabBarPosition = QPointF(0, q->height() - tabBarItem->height());
-      tabBarWidth = usableArea.width();
-      usableArea.setBottom(usableArea.bottom() - tabBarItem->height());
+      barPosition = QPointF(0, size.height() - tabBarItem->height());
+      barWidth = rc.width();
+      rc.setBottom(rc.bottom() - tabBarItem->height());
       break;
     }
     //        auto a = dockStyle->widgetTabPadding();
-    //        usableArea.adjust(a, a, -a, -a);
+    //        rc.adjust(a, a, -a, -a);
   }
-  return usableArea;
+  if (tabBarPosition)
+    *tabBarPosition = barPosition;
+  if (tabBarWidth)
+    *tabBarWidth = barWidth;
+  return rc;
 }
 
 DockArea::DockArea(QQuickItem *parent) : QQuickPaintedItem(parent), d_ptr(new DockAreaPrivate(this)) {
   Q_D(DockArea);
   d->area = Dock::Float;
   setClip(true);
-  setAcceptHoverEvents(true);
-  setAcceptedMouseButtons(Qt::LeftButton);
 
   AbstractStyle::registerThemableItem(this);
 }
@@ -352,124 +499,6 @@ DockArea::~DockArea() {
   delete d;
 }
 
-void DockArea::hoverMoveEvent(QHoverEvent *event) {
-  Q_D(DockArea);
-
-  if (d->mousePressed)
-    return;
-
-  switch (d->area) {
-  case Dock::Right:
-  case Dock::Left:
-    setCursor(d->acceptResizeEvent(event->pos()) ? Qt::SizeHorCursor : Qt::ArrowCursor);
-    break;
-
-  case Dock::Bottom:
-  case Dock::Top:
-    setCursor(d->acceptResizeEvent(event->pos()) ? Qt::SizeVerCursor : Qt::ArrowCursor);
-    break;
-
-  default:
-    break;
-  }
-}
-
-bool DockArea::childMouseEventFilter(QQuickItem *, QEvent *e) {
-  Q_D(DockArea);
-
-  static QPointF _lastMousePos;
-  static QPointF _lastChildPos;
-
-  auto me = static_cast<QMouseEvent *>(e);
-  switch (e->type()) {
-  case QEvent::MouseButtonPress:
-    _lastMousePos = me->windowPos();
-    _lastChildPos = position();
-    e->accept();
-    break;
-
-  case QEvent::MouseMove: {
-    auto pt = _lastChildPos + (me->windowPos() - _lastMousePos);
-    switch (d->area) {
-    case Dock::Right:
-    case Dock::Left:
-      setWidth(pt.x());
-      break;
-
-    case Dock::Bottom:
-    case Dock::Top:
-      break;
-
-    default:
-      break;
-    }
-
-    break;
-  }
-
-  default:
-    break;
-  }
-
-  return false;
-}
-
-void DockArea::mousePressEvent(QMouseEvent *event) {
-  Q_D(DockArea);
-
-  d->mousePressed = true;
-  switch (d->area) {
-  case Dock::Right:
-  case Dock::Left:
-    d->lastMousePos = event->windowPos().x();
-    d->lastGroupSize = width();
-    setKeepMouseGrab(true);
-    break;
-
-  case Dock::Bottom:
-  case Dock::Top:
-    d->lastMousePos = event->windowPos().y();
-    d->lastGroupSize = height();
-    setKeepMouseGrab(true);
-    break;
-
-  default:
-    break;
-  }
-}
-
-void DockArea::mouseMoveEvent(QMouseEvent *event) {
-  Q_D(DockArea);
-
-  switch (d->area) {
-  case Dock::Left:
-    setPanelSize(d->lastGroupSize + (event->windowPos().x() - d->lastMousePos));
-    break;
-
-  case Dock::Right:
-    setPanelSize(d->lastGroupSize + (d->lastMousePos - event->windowPos().x()));
-    break;
-
-  case Dock::Top:
-    setPanelSize(d->lastGroupSize + (event->windowPos().y() - d->lastMousePos));
-    break;
-
-  case Dock::Bottom:
-    setPanelSize(d->lastGroupSize + (d->lastMousePos - event->windowPos().y()));
-    break;
-
-  default:
-    break;
-  }
-}
-
-void DockArea::mouseReleaseEvent(QMouseEvent *event) {
-  Q_UNUSED(event)
-  Q_D(DockArea);
-  d->mousePressed = false;
-  setKeepMouseGrab(false);
-}
-
 void DockArea::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) {
   Q_D(DockArea);
 
@@ -496,13 +525,25 @@ void DockArea::updatePolish() {
 
 void DockArea::dockWidget_closed() {
   Q_D(DockArea);
-  if (d->displayType == Dock::TabbedView || d->displayType == Dock::StackedView) {
+  auto displayType = d->effectiveDisplayType();
+  if (displayType == Dock::TabbedView || displayType == Dock::StackedView) {
     removeDockWidget(qobject_cast<DockWidget *>(sender()));
   }
 }
 
 void DockArea::tabBar_tabClicked(int index) {
   Q_D(DockArea);
+  if (d->autoHide) {
+    if (d->expanded && index == d->currentIndex) {
+      setExpanded(false);
+      return;
+    }
+    setCurrentIndex(index);
+    setExpanded(true);
+    d->activateDockWidget(index);
+    return;
+  }
+
   if (d->displayType != Dock::TabbedView && d->displayType != Dock::StackedView)
     return;
 
@@ -511,6 +552,27 @@ void DockArea::tabBar_tabClicked(int index) {
   //    }
   //    d->tabBar->setCurrentIndex(index);
   setCurrentIndex(index);
+  d->activateDockWidget(index);
+}
+
+void DockArea::tabBar_tabHovered(int index) {
+  Q_D(DockArea);
+  if (!d->autoHide || d->expanded)
+    return;
+
+  setCurrentIndex(index);
+  setExpanded(true);
+  if (!d->expanded)
+    return;
+
+  d->expandedByHover = true;
+  d->setHoverTracking(true);
+}
+
+void DockArea::hoverLeaveEvent(QHoverEvent *event) {
+  Q_D(DockArea);
+  QQuickPaintedItem::hoverLeaveEvent(event);
+  d->pointerLeft(mapToScene(event->position()));
 }
 
 void DockArea::tabBar_closeButtonClicked(int index) {
@@ -520,6 +582,10 @@ void DockArea::tabBar_closeButtonClicked(int index) {
     item->close();
 }
 
+void DockArea::tabBar_tabDragged(int from, int to) {
+  moveDockWidget(from, to);
+}
+
 void DockArea::handler_moving(qreal pos, bool *ok) {
   Q_D(DockArea);
 
@@ -527,11 +593,16 @@ void DockArea::handler_moving(qreal pos, bool *ok) {
   if (!handler)
     return;
 
-  auto ps = handler->index() ? pos - d->handlers.at(handler->index() - 1)->pos() - dockStyle->resizeHandleSize() : pos;
+  // handler positions are in grip layer (container) coordinates
+  auto origin = d->isVertical() ? y() : x();
+  pos -= origin;
+
+  auto ps = handler->index() ? pos - (d->handlers.at(handler->index() - 1)->pos() - origin) - dockStyle->resizeHandleSize()
+                             : pos;
 
   auto ns = handler->index() == d->handlers.count() - 1
                 ? (d->isVertical() ? height() : width()) - pos - dockStyle->resizeHandleSize()
-                : d->handlers.at(handler->index() + 1)->pos() - pos - dockStyle->resizeHandleSize();
+                : (d->handlers.at(handler->index() + 1)->pos() - origin) - pos - dockStyle->resizeHandleSize();
 
   auto prevDockWidget = d->dockWidgets.at(handler->index());
   auto nextDockWidget = d->dockWidgets.at(handler->index() + 1);
@@ -578,6 +649,7 @@ void DockArea::handler_moved() {
     //*freeSize;
   }
   d->reorderItems();
+  Q_EMIT itemSizesChanged();
 }
 
 bool DockArea::isOpen() const {
@@ -642,26 +714,14 @@ void DockArea::componentComplete() {
     d->tabBar->setHeight(dockStyle->tabBarSize());
     d->tabBarItem = d->tabBar;
     connect(d->tabBar, &DockTabBar::tabClicked, this, &DockArea::tabBar_tabClicked);
+    connect(d->tabBar, &DockTabBar::tabHovered, this, &DockArea::tabBar_tabHovered);
     connect(d->tabBar, &DockTabBar::closeButtonClicked, this, &DockArea::tabBar_closeButtonClicked);
+    connect(d->tabBar, &DockTabBar::tabDragged, this, &DockArea::tabBar_tabDragged);
 
-    switch (d->tabPosition) {
-    case Qt::TopEdge:
-    case Qt::BottomEdge:
-      d->tabBarItem->setRotation(0);
-      break;
-
-    case Qt::LeftEdge:
-      d->tabBarItem->setRotation(-90);
-      break;
-
-    case Qt::RightEdge:
-      d->tabBarItem->setRotation(90);
-      break;
-    }
-    d->tabBar->setEdge(d->tabPosition);
+    d->applyTabPosition();
   }
 
-  d->tabBarItem->setVisible(d->displayType == Dock::TabbedView);
+  d->tabBarItem->setVisible(d->effectiveDisplayType() == Dock::TabbedView);
 }
 
 QQuickItem *DockArea::tabBar() const {
@@ -677,12 +737,13 @@ int DockArea::currentIndex() const {
 void DockArea::addDockWidget(DockWidget *item) {
   Q_D(DockArea);
 
-  if (d->dockWidgets.contains(item))
+  if (d->dockWidgetIndexes.contains(item))
     return;
 
   item->setArea(d->area);
   item->setDockArea(this);
 
+  d->dockWidgetIndexes.insert(item, d->dockWidgets.size());
   d->dockWidgets.append(item);
   d->normalizeItemSizes();
 
@@ -706,18 +767,26 @@ void DockArea::addDockWidget(DockWidget *item) {
   connect(item, &DockWidget::closed, this, &DockArea::dockWidget_closed);
 
   setIsOpen(d->dockWidgets.count());
+  Q_EMIT dockWidgetAdded(item, d->dockWidgets.count() - 1);
   Q_EMIT dockWidgetsChanged(d->dockWidgets);
 }
 
+int DockArea::indexOf(DockWidget *widget) const {
+  Q_D(const DockArea);
+  return d->dockWidgetIndexes.value(widget, -1);
+}
+
 void DockArea::removeDockWidget(DockWidget *item) {
   Q_D(DockArea);
-  auto index = d->dockWidgets.indexOf(item);
+  auto index = indexOf(item);
   if (index == -1)
     return;
 
-  auto removedTabIndex = d->dockWidgets.indexOf(item);
+  auto removedTabIndex = index;
 
-  d->dockWidgets.removeOne(item);
+  d->dockWidgets.removeAt(index);
+  d->dockWidgetIndexes.remove(item);
+  d->reindexDockWidgets(index);
   item->setDockArea(nullptr);
 
   if (d->tabBar) {
@@ -727,15 +796,16 @@ void DockArea::removeDockWidget(DockWidget *item) {
   }
   setCurrentIndex(currentIndex());
   setIsOpen(d->dockWidgets.count());
+  if (!d->dockWidgets.count())
+    setExpanded(false);
 
-  // remove one handler
+  // give one handler back to the pool
   if (d->handlers.count()) {
     auto h = d->handlers.takeAt(d->handlers.count() - 1);
+    auto layer = d->gripLayer();
 
-    if (h) {
-      h->setParentItem(nullptr);
-      h->deleteLater();
-    }
+    if (h && layer)
+      layer->releaseHandler(h);
   }
   d->normalizeItemSizes();
   d->relayout();
@@ -758,6 +828,37 @@ void DockArea::removeDockWidget(DockWidget *item) {
   //        d->reorderHandles();
   //    d->reorderItems();
 
+  Q_EMIT dockWidgetRemoved(item, index);
+  Q_EMIT dockWidgetsChanged(d->dockWidgets);
+}
+
+void DockArea::moveDockWidget(int from, int to) {
+  Q_D(DockArea);
+  if (from < 0 || from >= d->dockWidgets.count() || to < 0 || to >= d->dockWidgets.count() || from == to)
+    return;
+
+  auto item = d->dockWidgets.at(from);
+  auto current = d->currentIndex >= 0 ? d->dockWidgets.at(d->currentIndex) : nullptr;
+
+  d->dockWidgets.move(from, to);
+  if (d->itemSizes.size() == d->dockWidgets.size())
+    d->itemSizes.move(from, to);
+  d->reindexDockWidgets(qMin(from, to));
+
+  if (d->tabBar)
+    d->tabBar->moveTab(from, to);
+
+  // the same dock stays current, only its index follows it
+  if (current && d->dockWidgets.at(d->currentIndex) != current) {
+    d->currentIndex = d->dockWidgetIndexes.value(current);
+    if (d->tabBar)
+      d->tabBar->setCurrentIndex(d->currentIndex);
+    Q_EMIT currentIndexChanged(d->currentIndex);
+  }
+
+  d->relayout();
+
+  Q_EMIT dockWidgetMoved(item, from, to);
   Q_EMIT dockWidgetsChanged(d->dockWidgets);
 }
 
@@ -803,9 +904,9 @@ void DockArea::setDisplayType(Dock::DockWidgetDisplayType displayType) {
   if (d->displayType == displayType)
     return;
 
-  if (d->tabBarItem)
-    d->tabBarItem->setVisible(displayType == Dock::TabbedView);
   d->displayType = displayType;
+  if (d->tabBarItem)
+    d->tabBarItem->setVisible(d->effectiveDisplayType() == Dock::TabbedView);
   Q_EMIT displayTypeChanged(displayType);
 }
 
@@ -844,26 +945,10 @@ void DockArea::setTabPosition(Qt::Edge tabPosition) {
   if (!isComponentComplete())
     return;
 
-  if (d->tabBarItem)
-    switch (tabPosition) {
-    case Qt::TopEdge:
-    case Qt::BottomEdge:
-      d->tabBarItem->setRotation(0);
-      break;
-
-    case Qt::LeftEdge:
-      d->tabBarItem->setRotation(-90);
-      break;
-
-    case Qt::RightEdge:
-      d->tabBarItem->setRotation(90);
-      break;
-    }
+  d->applyTabPosition();
 
   // d->updateUsableArea();
 
-  if (d->tabBar)
-    d->tabBar->setEdge(tabPosition);
   geometryChange(QRectF(), QRectF());
   update();
   Q_EMIT tabPositionChanged(d->tabPosition);
@@ -876,13 +961,10 @@ void DockArea::setCurrentIndex(int currentIndex) {
   if (d->currentIndex == newIndex)
     return;
 
-  if (d->currentIndex > 0 && d->currentIndex < d->dockWidgets.size())
-    d->dockWidgets.at(d->currentIndex)->setIsActive(false);
-
+  // isActive follows focus and is owned by the container, not by the tab shown
   d->currentIndex = newIndex;
-  d->dockWidgets.at(d->currentIndex)->setIsActive(true);
 
-  if (d->displayType == Dock::TabbedView || d->displayType == Dock::StackedView)
+  if (d->effectiveDisplayType() == Dock::TabbedView || d->effectiveDisplayType() == Dock::StackedView)
     d->updateTabbedView();
 
   Q_EMIT currentIndexChanged(d->currentIndex);
@@ -900,6 +982,70 @@ void DockArea::setTabBar(QQuickItem *tabBar) {
   Q_EMIT tabBarChanged(tabBar);
 }
 
+bool DockArea::autoHide() const {
+  Q_D(const DockArea);
+  return d->autoHide;
+}
+
+bool DockArea::expanded() const {
+  Q_D(const DockArea);
+  return d->expanded;
+}
+
+void DockArea::setAutoHide(bool autoHide) {
+  Q_D(DockArea);
+  if (d->autoHide == autoHide)
+    return;
+
+  if (!autoHide)
+    setExpanded(false);
+
+  d->autoHide = autoHide;
+  if (d->tabBarItem)
+    d->tabBarItem->setVisible(d->effectiveDisplayType() == Dock::TabbedView);
+  if (isComponentComplete())
+    d->applyTabPosition();
+  polish();
+  Q_EMIT autoHideChanged(d->autoHide);
+}
+
+void DockArea::setExpanded(bool expanded) {
+  Q_D(DockArea);
+  if (d->expanded == expanded || (expanded && (!d->autoHide || !d->dockWidgets.count())))
+    return;
+
+  d->expanded = expanded;
+  if (d->expandedByHover) {
+    d->expandedByHover = false;
+    d->setHoverTracking(false);
+  }
+  if (d->layoutRect.isValid())
+    d->applyLayoutRect();
+  polish();
+  update();
+  Q_EMIT expandedChanged(d->expanded);
+}
+
+void DockArea::setLayoutRect(const QRectF &rect) {
+  Q_D(DockArea);
+  d->layoutRect = rect;
+  d->applyLayoutRect();
+}
+
+qreal DockArea::stripSize() const {
+  return dockStyle->tabBarSize() + 2;
+}
+
+Qt::Edge DockArea::effectiveTabPosition() const {
+  Q_D(const DockArea);
+  return d->effectiveTabPosition();
+}
+
+Dock::DockWidgetDisplayType DockArea::effectiveDisplayType() const {
+  Q_D(const DockArea);
+  return d->effectiveDisplayType();
+}
+
 void DockArea::paint(QPainter *painter) {
   dockStyle->paintDockArea(painter, this);
 }
@@ -24,6 +24,8 @@ class DockArea : public QQuickPaintedItem {
   Q_PROPERTY(int currentIndex READ currentIndex WRITE setCurrentIndex NOTIFY currentIndexChanged)
   Q_PROPERTY(Qt::Edge tabPosition READ tabPosition WRITE setTabPosition NOTIFY tabPositionChanged)
   Q_PROPERTY(QQuickItem *tabBar READ tabBar WRITE setTabBar NOTIFY tabBarChanged)
+  Q_PROPERTY(bool autoHide READ autoHide WRITE setAutoHide NOTIFY autoHideChanged)
+  Q_PROPERTY(bool expanded READ expanded WRITE setExpanded NOTIFY expandedChanged)
 
   Q_DECLARE_PRIVATE(DockArea);
   DockAreaPrivate *d_ptr;
@@ -43,14 +45,23 @@ public:
   qreal minimumSize() const;
   qreal maximumSize() const;
   QList<DockWidget *> dockWidgets() const;
+  Q_INVOKABLE int indexOf(DockWidget *widget) const;
   int currentIndex() const;
   Qt::Edge tabPosition() const;
 
   QQuickItem *tabBar() const;
 
+  bool autoHide() const;
+  bool expanded() const;
+  Qt::Edge effectiveTabPosition() const;
+  Dock::DockWidgetDisplayType effectiveDisplayType() const;
+
 private:
   void addDockWidget(DockWidget *item);
   void removeDockWidget(DockWidget *item);
+  void moveDockWidget(int from, int to);
+  void setLayoutRect(const QRectF &rect);
+  qreal stripSize() const;
 
 public Q_SLOTS:
   void setIsOpen(bool isOpen);
@@ -65,6 +76,9 @@ public Q_SLOTS:
 
   void setTabBar(QQuickItem *tabBar);
 
+  void setAutoHide(bool autoHide);
+  void setExpanded(bool expanded);
+
 Q_SIGNALS:
   void requestResize(const QRectF &rect, bool *ok);
   void isOpenChanged(bool isOpen);
@@ -75,28 +89,35 @@ Q_SIGNALS:
   void minimumSizeChanged(qreal minimumSize);
   void maximumSizeChanged(qreal maximumSize);
   void dockWidgetsChanged(QList<DockWidget *> name);
+  void dockWidgetAdded(DockWidget *widget, int index);
+  void dockWidgetRemoved(DockWidget *widget, int index);
+  void dockWidgetMoved(DockWidget *widget, int from, int to);
+  void itemSizesChanged();
   void currentIndexChanged(int currentIndex);
   void tabPositionChanged(Qt::Edge tabPosition);
 
   void tabBarChanged(QQuickItem *tabBar);
 
+  void autoHideChanged(bool autoHide);
+  void expandedChanged(bool expanded);
+
 protected:
   void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
   void updatePolish() override;
-  void hoverMoveEvent(QHoverEvent *event) override;
-  bool childMouseEventFilter(QQuickItem *, QEvent *) override;
-  void mousePressEvent(QMouseEvent *event) override;
-  void mouseMoveEvent(QMouseEvent *event) override;
-  void mouseReleaseEvent(QMouseEvent *event) override;
+  void hoverLeaveEvent(QHoverEvent *event) override;
 
 private Q_SLOTS:
   void dockWidget_closed();
   void tabBar_tabClicked(int index);
+  void tabBar_tabHovered(int index);
   void tabBar_closeButtonClicked(int index);
+  void tabBar_tabDragged(int from, int to);
   void handler_moving(qreal pos, bool *ok);
   void handler_moved();
 
   friend class DockContainer;
+  friend class DockMoveGuide;
+  friend class DockWidget;
 };
 
 #endif // DOCKAREA_H
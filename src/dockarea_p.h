@@ -2,6 +2,7 @@
 #define DOCKAREA_P_H
 
 #include <QColor>
+#include <QHash>
 #include <QMap>
 #include <QPointF>
 #include <QRectF>
@@ -12,6 +13,7 @@ class DockWidget;
 class DockArea;
 class DockAreaResizeHandler;
 class DockTabBar;
+class DockGripLayer;
 
 class DockAreaPrivate {
   DockArea *q_ptr;
@@ -22,14 +24,12 @@ public:
 
   qreal panelSize;
   QList<DockWidget *> dockWidgets;
+  QHash<DockWidget *, int> dockWidgetIndexes;
   QList<DockAreaResizeHandler *> handlers;
   QList<qreal> itemSizes;
 
   int currentIndex;
   bool isOpen;
-  qreal lastGroupSize;
-  qreal lastMousePos;
-  bool mousePressed;
   Dock::Area area;
   bool enableResizing;
   DockTabBar *tabBar;
@@ -39,19 +39,44 @@ public:
   QPointF tabBarPosition;
   qreal tabBarWidth;
 
+  // auto-hide: the container reserves only a strip of tabs (layoutRect), the
+  // expanded panel is laid over the neighbour areas without resizing them
+  bool autoHide;
+  bool expanded;
+  QRectF layoutRect;
+  // opened by hovering a tab, closes again once the pointer leaves it
+  bool expandedByHover;
+
+  // set while a maximized widget of this area freezes its layout
+  bool relayoutPending;
+
   void relayout();
   void arrangeTabBar();
   bool isHorizontal() const;
   bool isVertical() const;
-  bool acceptResizeEvent(const QPointF &point);
+  bool isCollapsed() const;
+  Dock::DockWidgetDisplayType effectiveDisplayType() const;
+  Qt::Edge effectiveTabPosition() const;
+  void applyTabPosition();
+  void setHoverTracking(bool hoverTracking);
+  void pointerLeft(const QPointF &scenePos);
+  void activateDockWidget(int index);
+  QRectF overlayRect(const QRectF &rect) const;
+  QRectF dropRect(const QRectF &rect, int index) const;
+  QList<QRectF> splitRects(const QRectF &rect, const QRectF &usable, const QList<qreal> &sizes) const;
+  void applyLayoutRect();
   void fitItem(QQuickItem *item);
   void reorderItems();
   void reorderHandles();
   void normalizeItemSizes();
+  static void normalizeSizes(QList<qreal> *sizes);
+  void reindexDockWidgets(int from);
 
   void updateTabbedView();
   QRectF updateUsableArea();
+  QRectF usableAreaFor(const QSizeF &size, QPointF *tabBarPosition, qreal *tabBarWidth) const;
   DockAreaResizeHandler *createHandlers();
+  DockGripLayer *gripLayer() const;
 
   qreal minimumSize;
   qreal maximumSize;
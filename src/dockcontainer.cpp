@@ -2,39 +2,90 @@
 #include "dockcontainer_p.h"
 #include "dockmoveguide.h"
 #include "dockwidget.h"
+#include "dockwidget_p.h"
 #include "dockarea.h"
+#include "dockarea_p.h"
+#include "dockcontentincubator.h"
+#include "dockdragsession.h"
+#include "dockgriplayer.h"
+#include "docklayouthistory.h"
+#include "docklayoutjournal.h"
+#include "docklayoutmodel.h"
+#include "dockquickopenmodel.h"
 #include "dockgroupresizehandler.h"
 #include "style/abstractstyle.h"
 #include "dockwindow.h"
 #include "dockarea.h"
 #include "dockwidgetmovehandler.h"
 #include "dockwidgetheader.h"
+#include "dockwidgetattached.h"
 
 #include <QDebug>
+#include <QGuiApplication>
 #include <QPainter>
+#include <QQmlEngine>
+#include <QSet>
 #include <QSettings>
+#include <QStandardPaths>
+#include <QTimer>
 #define Z_GROUP 100
 #define Z_WIDGET 200
 #define Z_WIDGET_FLOAT 300
+#define Z_OVERLAY 350
 #define Z_RESIZER 400
+#define Z_MAXIMIZED 450
 #define Z_GUIDE 500
 
+// every container of the process, a drag can end in any of them
+Q_GLOBAL_STATIC(QList<DockContainer *>, containerRegistry)
+
 DockContainerPrivate::DockContainerPrivate(DockContainer *parent)
     : q_ptr(parent), topLeftOwner{Qt::LeftEdge}, topRightOwner{Qt::RightEdge}, bottomLeftOwner{Qt::LeftEdge},
-      bottomRightOwner{Qt::RightEdge}, activeDockWidget{nullptr}, defaultDisplayType{Dock::SplitView} {}
+      bottomRightOwner{Qt::RightEdge}, activeDockWidget{nullptr}, defaultDisplayType{Dock::SplitView},
+      enableStateStoring{false}, batchDepth{0}, autoSave{false}, autoSaveDelay{1000}, journal{nullptr},
+      pendingHistoryKind{0}, historyLocked{0}, maximizedWidget{nullptr}, layoutDirty{false},
+      suspendContentOnMaximize{false}, contentBudget{0}, contentBudgetMode{DockContainer::ItemCount}, contentUsed{0},
+      incubationController{nullptr}, incubationBudget{0}, prewarmCount{0}, floatingLayer{Z_WIDGET_FLOAT, Z_OVERLAY},
+      layoutModel{nullptr}, quickOpenModel{nullptr} {}
 
 DockContainer::DockContainer(QQuickItem *parent) : QQuickPaintedItem(parent), d_ptr(new DockContainerPrivate(this)) {
   Q_D(DockContainer);
   d->dockMoveGuide = new DockMoveGuide(this);
+  d->gripLayer = new DockGripLayer(this);
+  d->gripLayer->setZ(Z_RESIZER);
+
+  d->preloadTimer = new QTimer(this);
+  d->preloadTimer->setSingleShot(true);
+  d->preloadTimer->setInterval(0);
+  connect(d->preloadTimer, &QTimer::timeout, this, &DockContainer::preloadNextContent);
+
+  d->occlusionTimer = new QTimer(this);
+  d->occlusionTimer->setSingleShot(true);
+  d->occlusionTimer->setInterval(0);
+  connect(d->occlusionTimer, &QTimer::timeout, this, &DockContainer::updateOcclusion);
+
+  d->historyTimer = new QTimer(this);
+  d->historyTimer->setSingleShot(true);
+  d->historyTimer->setInterval(300);
+  connect(d->historyTimer, &QTimer::timeout, this, &DockContainer::historyTimer_timeout);
+
+  d->autoSaveTimer = new QTimer(this);
+  d->autoSaveTimer->setSingleShot(true);
+  d->autoSaveTimer->setInterval(d->autoSaveDelay);
+  connect(d->autoSaveTimer, &QTimer::timeout, this, &DockContainer::autoSaveTimer_timeout);
 
   setFiltersChildMouseEvents(true);
   AbstractStyle::registerThemableItem(this);
+  containerRegistry()->append(this);
 }
 
 DockContainer::~DockContainer() {
   Q_D(DockContainer);
-  if (d->enableStateStoring)
+  containerRegistry()->removeOne(this);
+  if (d->enableStateStoring || d->autoSave)
     storeSettings();
+  // waits for the pending writes
+  delete d->journal;
   delete d;
 }
 
@@ -49,28 +100,60 @@ void DockContainer::componentComplete() {
     createGroup(Dock::Center);
     d->dockAreas[Dock::Center]->setDisplayType(Dock::TabbedView);
   }
-  connect(window(), &QQuickWindow::activeFocusItemChanged, [this, d]() {
-    //        auto dockWidget = Dock::findInParents<DockWidget>(
-    //            window()->activeFocusItem());
-    //        if (dockWidget) {
-    //            if (d->activeDockWidget)
-    //                d->activeDockWidget->setIsActive(false);
-    //            d->activeDockWidget = dockWidget;
-    //            d->activeDockWidget->setIsActive(true);
-    //        }
-  });
+  disconnect(d->focusConnection);
+  if (window())
+    d->focusConnection =
+        connect(window(), &QQuickWindow::activeFocusItemChanged, this, &DockContainer::window_activeFocusItemChanged);
   createGroup(Dock::Left);
   createGroup(Dock::Right);
   createGroup(Dock::Top);
   createGroup(Dock::Bottom);
 
+  // widgets and the stored layout go in as one pass, laid out once at the end
+  beginBatch();
+
+  // a compiled default layout goes in first so every dock lands in its area
+  // directly, the second pass only fixes the tab order
+  const DockLayoutSnapshot *defaultLayout = nullptr;
+  if (!d->defaultLayout.isEmpty()) {
+    defaultLayout = DockLayoutSnapshot::registeredLayout(d->defaultLayout);
+    if (defaultLayout)
+      applyLayout(*defaultLayout);
+    else
+      qWarning() << "No compiled dock layout named" << d->defaultLayout;
+  }
+
   for (auto &dw : d->initialWidgets)
     addDockWidget(dw);
 
+  if (defaultLayout)
+    applyLayout(*defaultLayout);
+
+  if (d->enableStateStoring || d->autoSave)
+    restoreSettings();
+
   for (auto i = d->dockAreas.begin(); i != d->dockAreas.end(); i++) {
     const auto &dg = *i;
     connect(dg, &DockArea::panelSizeChanged, this, &DockContainer::reorderDockAreas);
     connect(dg, &DockArea::isOpenChanged, this, &DockContainer::reorderDockAreas);
+    connect(dg, &DockArea::autoHideChanged, this, &DockContainer::reorderDockAreas);
+    connect(dg, &DockArea::expandedChanged, this, &DockContainer::dockArea_expandedChanged);
+
+    connect(dg, &DockArea::panelSizeChanged, this, &DockContainer::scheduleAutoSave);
+    connect(dg, &DockArea::autoHideChanged, this, &DockContainer::scheduleAutoSave);
+    connect(dg, &DockArea::displayTypeChanged, this, &DockContainer::scheduleAutoSave);
+    connect(dg, &DockArea::currentIndexChanged, this, &DockContainer::scheduleAutoSave);
+    connect(dg, &DockArea::dockWidgetAdded, this, &DockContainer::scheduleAutoSave);
+    connect(dg, &DockArea::dockWidgetRemoved, this, &DockContainer::scheduleAutoSave);
+    connect(dg, &DockArea::dockWidgetMoved, this, &DockContainer::scheduleAutoSave);
+
+    // panel resizes arrive once per mouse move and are recorded when they settle
+    connect(dg, &DockArea::panelSizeChanged, this,
+            [this, dg]() { scheduleLayoutChange(DockLayoutHistory::PanelResize, QString::number(dg->area())); });
+    connect(dg, &DockArea::itemSizesChanged, this,
+            [this, dg]() { recordLayoutChange(DockLayoutHistory::SplitRatio, QString::number(dg->area())); });
+    connect(dg, &DockArea::dockWidgetMoved, this,
+            [this](DockWidget *widget) { recordLayoutChange(DockLayoutHistory::Move, widget->uniqueId()); });
   }
 
   d->dockAreas[Dock::Left]->polish();
@@ -81,29 +164,459 @@ void DockContainer::componentComplete() {
   //    reorderDockAreas();
   //    geometryChange(QRectF(), QRectF());
 
-  reorderDockAreas();
+  if (d->layoutModel)
+    d->layoutModel->reset();
+
+  endBatch();
 
   QQuickItem::componentComplete();
+
+  // undo starts from the restored layout
+  d->historyBase = saveLayout();
 }
 
 void DockContainer::storeSettings() {
   Q_D(DockContainer);
+  auto snapshot = saveLayout();
+
+  if (d->autoSave) {
+    d->autoSaveTimer->stop();
+    journal()->compact(snapshot);
+    return;
+  }
+
+  if (!d->layoutFile.isEmpty()) {
+    snapshot.toFile(d->layoutFile);
+    return;
+  }
+
+  QSettings set;
+  set.setValue("dockLayout", snapshot.toByteArray());
+}
+
+void DockContainer::restoreSettings() {
+  Q_D(DockContainer);
+  DockLayoutSnapshot snapshot;
+
+  if (d->autoSave) {
+    if (journal()->recover(&snapshot))
+      applyLayout(snapshot);
+    return;
+  }
+
+  if (!d->layoutFile.isEmpty()) {
+    if (DockLayoutSnapshot::fromFile(d->layoutFile, &snapshot))
+      applyLayout(snapshot);
+    return;
+  }
+
   QSettings set;
-  QMetaEnum e = QMetaEnum::fromType<Dock::Area>();
+  auto data = set.value("dockLayout").toByteArray();
+  if (!data.isEmpty() && DockLayoutSnapshot::fromByteArray(data, &snapshot))
+    applyLayout(snapshot);
+}
+
+DockLayoutSnapshot DockContainer::saveLayout() const {
+  Q_D(const DockContainer);
+  DockLayoutSnapshot snapshot;
+
+  for (auto &da : d->dockAreas) {
+    DockLayoutSnapshot::Area a;
+    a.area = da->area();
+    a.panelSize = da->panelSize();
+    a.autoHide = da->autoHide();
+    a.displayType = da->displayType();
+    a.currentIndex = da->currentIndex();
+    for (auto &dw : da->dockWidgets())
+      a.widgets.append(dw->uniqueId());
+    a.itemSizes = da->d_func()->itemSizes;
+    snapshot.areas.append(a);
+  }
 
   for (auto &dw : d->dockWidgets) {
-    set.beginGroup(dw->title());
-    set.setValue("area", e.valueToKey(dw->area()));
-    set.setValue("position", QStringLiteral("%1,%2").arg(dw->x()).arg(dw->y()));
-    set.setValue("size", QStringLiteral("%1,%2").arg(dw->width()).arg(dw->height()));
-    set.setValue("visible", dw->isVisible());
-    set.endGroup();
+    DockLayoutSnapshot::Widget w;
+    w.id = dw->uniqueId();
+    w.area = dw->area();
+    w.closed = dw->d_func()->isClosed;
+    // docked geometry follows from the areas, only free docks keep their own
+    if (dw->area() == Dock::Detached && dw->dockWindow())
+      w.geometry = dw->dockWindow()->geometry();
+    else if (dw->area() == Dock::Float)
+      w.geometry = QRectF(dw->position(), dw->size());
+    snapshot.widgets.append(w);
+  }
+
+  return snapshot;
+}
+
+void DockContainer::applyLayout(const DockLayoutSnapshot &snapshot) {
+  // only what differs from the current layout is touched; docks the
+  // snapshot does not mention stay where they are
+  applyDelta(DockLayoutSnapshot::diff(saveLayout(), snapshot));
+}
+
+void DockContainer::applyDelta(const DockLayoutSnapshot::Delta &delta) {
+  Q_D(DockContainer);
+  if (delta.areas.isEmpty() && delta.widgets.isEmpty())
+    return;
+
+  ++d->historyLocked;
+  beginBatch();
+
+  for (auto &a : delta.areas) {
+    auto da = d->dockAreas.value(static_cast<Dock::Area>(a.area));
+    if (!da)
+      continue;
+    da->setDisplayType(static_cast<Dock::DockWidgetDisplayType>(a.displayType));
+    da->setAutoHide(a.autoHide);
+    if (a.panelSize >= 0)
+      da->setPanelSize(a.panelSize);
+  }
+
+  for (auto &w : delta.widgets) {
+    auto dw = findDockWidget(w.id);
+    if (dw)
+      applyWidgetLayout(dw, w);
+    else
+      d->pendingLayout.insert(w.id, w);
+  }
+
+  for (auto &a : delta.areas) {
+    auto da = d->dockAreas.value(static_cast<Dock::Area>(a.area));
+    if (da)
+      applyAreaOrder(da, a);
+  }
+
+  endBatch();
+  --d->historyLocked;
+}
+
+QStringList DockContainer::perspectives() const {
+  Q_D(const DockContainer);
+  return d->perspectives.keys();
+}
+
+QString DockContainer::currentPerspective() const {
+  Q_D(const DockContainer);
+  return d->currentPerspective;
+}
+
+void DockContainer::savePerspective(const QString &name) {
+  Q_D(DockContainer);
+  auto isNew = !d->perspectives.contains(name);
+
+  d->perspectives.insert(name, saveLayout());
+  if (isNew)
+    Q_EMIT perspectivesChanged();
+
+  if (d->currentPerspective != name) {
+    d->currentPerspective = name;
+    Q_EMIT currentPerspectiveChanged(d->currentPerspective);
+  }
+}
+
+bool DockContainer::switchPerspective(const QString &name) {
+  Q_D(DockContainer);
+  auto i = d->perspectives.constFind(name);
+  if (i == d->perspectives.constEnd()) {
+    qWarning() << "No dock perspective named" << name;
+    return false;
+  }
+
+  applyLayout(*i);
+  recordLayoutChange(DockLayoutHistory::Layout);
+
+  if (d->currentPerspective != name) {
+    d->currentPerspective = name;
+    Q_EMIT currentPerspectiveChanged(d->currentPerspective);
+  }
+  return true;
+}
+
+void DockContainer::removePerspective(const QString &name) {
+  Q_D(DockContainer);
+  if (!d->perspectives.remove(name))
+    return;
+
+  Q_EMIT perspectivesChanged();
+
+  if (d->currentPerspective == name) {
+    d->currentPerspective.clear();
+    Q_EMIT currentPerspectiveChanged(d->currentPerspective);
+  }
+}
+
+QByteArray DockContainer::saveState() const {
+  return saveLayout().toByteArray();
+}
+
+bool DockContainer::restoreState(const QByteArray &state) {
+  DockLayoutSnapshot snapshot;
+  if (!DockLayoutSnapshot::fromByteArray(state, &snapshot))
+    return false;
+
+  applyLayout(snapshot);
+  recordLayoutChange(DockLayoutHistory::Layout);
+  return true;
+}
+
+bool DockContainer::canUndo() const {
+  Q_D(const DockContainer);
+  return d->history.canUndo();
+}
+
+bool DockContainer::canRedo() const {
+  Q_D(const DockContainer);
+  return d->history.canRedo();
+}
+
+int DockContainer::undoLimit() const {
+  Q_D(const DockContainer);
+  return d->history.capacity();
+}
+
+void DockContainer::setUndoLimit(int undoLimit) {
+  Q_D(DockContainer);
+
+  if (d->history.capacity() == undoLimit)
+    return;
+
+  d->history.setCapacity(undoLimit);
+  Q_EMIT undoLimitChanged(d->history.capacity());
+  Q_EMIT historyChanged();
+}
+
+void DockContainer::undo() {
+  Q_D(DockContainer);
+  flushHistory();
+
+  auto command = d->history.undo();
+  if (!command)
+    return;
+
+  applyDelta(command->undo);
+  d->historyBase = saveLayout();
+  Q_EMIT historyChanged();
+}
+
+void DockContainer::redo() {
+  Q_D(DockContainer);
+  flushHistory();
+
+  auto command = d->history.redo();
+  if (!command)
+    return;
+
+  applyDelta(command->redo);
+  d->historyBase = saveLayout();
+  Q_EMIT historyChanged();
+}
+
+void DockContainer::clearHistory() {
+  Q_D(DockContainer);
+  d->historyTimer->stop();
+  d->history.clear();
+  d->historyBase = saveLayout();
+  Q_EMIT historyChanged();
+}
+
+void DockContainer::recordLayoutChange(int kind, const QString &key) {
+  Q_D(DockContainer);
+  if (!isComponentComplete() || d->historyLocked)
+    return;
+
+  // a pending gesture happened first, keep it as its own entry
+  flushHistory();
+
+  auto current = saveLayout();
+  auto redo = DockLayoutSnapshot::diff(d->historyBase, current);
+  if (redo.areas.isEmpty() && redo.widgets.isEmpty())
+    return;
+
+  d->history.push(static_cast<DockLayoutHistory::Kind>(kind), key, redo,
+                  DockLayoutSnapshot::diff(current, d->historyBase));
+  d->historyBase = current;
+  Q_EMIT historyChanged();
+}
+
+void DockContainer::scheduleLayoutChange(int kind, const QString &key) {
+  Q_D(DockContainer);
+  if (!isComponentComplete() || d->historyLocked)
+    return;
+
+  if (d->historyTimer->isActive() && (d->pendingHistoryKind != kind || d->pendingHistoryKey != key))
+    flushHistory();
+
+  d->pendingHistoryKind = kind;
+  d->pendingHistoryKey = key;
+  d->historyTimer->start();
+}
+
+void DockContainer::flushHistory() {
+  Q_D(DockContainer);
+  if (!d->historyTimer->isActive())
+    return;
+
+  d->historyTimer->stop();
+  historyTimer_timeout();
+}
+
+void DockContainer::historyTimer_timeout() {
+  Q_D(DockContainer);
+  recordLayoutChange(d->pendingHistoryKind, d->pendingHistoryKey);
+}
+
+QString DockContainer::layoutPath() const {
+  Q_D(const DockContainer);
+  if (!d->layoutFile.isEmpty())
+    return d->layoutFile;
+  return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/docklayout.bin");
+}
+
+DockLayoutJournal *DockContainer::journal() {
+  Q_D(DockContainer);
+  if (!d->journal)
+    d->journal = new DockLayoutJournal(layoutPath());
+  return d->journal;
+}
+
+void DockContainer::scheduleAutoSave() {
+  Q_D(DockContainer);
+  if (d->autoSave && isComponentComplete())
+    d->autoSaveTimer->start();
+}
+
+void DockContainer::autoSaveTimer_timeout() {
+  // only the diff to the last save is handed to the worker thread
+  journal()->append(saveLayout());
+}
+
+void DockContainer::beginBatch() {
+  Q_D(DockContainer);
+  ++d->batchDepth;
+}
+
+void DockContainer::endBatch() {
+  Q_D(DockContainer);
+  if (--d->batchDepth > 0)
+    return;
+
+  for (auto &da : d->dockAreas)
+    if (da->d_func()->relayoutPending)
+      da->d_func()->relayout();
+
+  reorderDockAreas();
+}
+
+void DockContainer::placeDockWidget(DockWidget *widget, Dock::Area area) {
+  Q_D(DockContainer);
+
+  switch (area) {
+  case Dock::Left:
+  case Dock::Right:
+  case Dock::Top:
+  case Dock::Bottom:
+  case Dock::Center: {
+    auto da = d->dockAreas.value(area);
+    if (!da || widget->dockArea() == da)
+      break;
+    if (widget->dockArea())
+      widget->dockArea()->removeDockWidget(widget);
+    if (widget->area() == Dock::Detached)
+      widget->setArea(area);
+    da->addDockWidget(widget);
+    d->floatingLayer.remove(widget);
+    widget->setZ(Z_WIDGET);
+    break;
+  }
+
+  case Dock::Float:
+  case Dock::Detached:
+    if (widget->dockArea())
+      widget->dockArea()->removeDockWidget(widget);
+    widget->setArea(area);
+    if (area == Dock::Float) {
+      d->floatingLayer.raise(widget);
+    } else {
+      d->floatingLayer.remove(widget);
+      widget->setZ(Z_WIDGET_FLOAT);
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+void DockContainer::setDockWidgetClosed(DockWidget *widget, bool closed) {
+  Q_D(DockContainer);
+  if (widget->d_func()->isClosed == closed)
+    return;
+
+  widget->d_func()->isClosed = closed;
+  if (closed) {
+    if (widget == d->maximizedWidget)
+      restoreDockWidget();
+    if (widget->dockArea())
+      widget->dockArea()->removeDockWidget(widget);
+    widget->setParentItem(nullptr);
+  } else {
+    widget->setParentItem(this);
+    widget->setVisible(true);
+  }
+}
+
+void DockContainer::applyWidgetLayout(DockWidget *widget, const DockLayoutSnapshot::Widget &layout) {
+  auto area = static_cast<Dock::Area>(layout.area);
+
+  if (layout.closed) {
+    setDockWidgetClosed(widget, true);
+    // reopening puts it back into the stored area
+    if (area != Dock::Detached)
+      widget->setArea(area);
+    return;
+  }
+
+  setDockWidgetClosed(widget, false);
+
+  if (area == Dock::Float || area == Dock::Detached) {
+    widget->setSize(layout.geometry.size());
+    if (area == Dock::Float)
+      widget->setPosition(layout.geometry.topLeft());
   }
 
-  set.sync();
+  placeDockWidget(widget, area);
+
+  if (area == Dock::Detached && widget->dockWindow())
+    widget->dockWindow()->setGeometry(layout.geometry.toRect());
 }
 
-void DockContainer::restoreSettings() {}
+void DockContainer::applyAreaOrder(DockArea *area, const DockLayoutSnapshot::Area &layout) {
+  QList<DockWidget *> order;
+  for (auto &id : layout.widgets) {
+    auto dw = findDockWidget(id);
+    if (dw && dw->dockArea() == area)
+      order.append(dw);
+  }
+
+  // docks the snapshot does not know end up after the stored ones
+  for (int i = 0; i < order.size(); ++i) {
+    auto from = area->indexOf(order.at(i));
+    if (from != i)
+      area->moveDockWidget(from, i);
+  }
+
+  auto ad = area->d_func();
+  if (ad->itemSizes.size() == layout.itemSizes.size() && ad->itemSizes != layout.itemSizes) {
+    ad->itemSizes = layout.itemSizes;
+    // waits for endBatch() inside a batch; history ignores it while restoring
+    ad->relayout();
+    Q_EMIT area->itemSizesChanged();
+  }
+
+  if (layout.currentIndex >= 0 && layout.currentIndex < area->dockWidgets().size())
+    area->setCurrentIndex(layout.currentIndex);
+}
 
 void DockContainer::paint(QPainter *painter) {
   dockStyle->paintDockContainer(painter, this);
@@ -114,13 +627,36 @@ QList<DockWidget *> DockContainer::dockWidgets() const {
   return d->dockWidgets;
 }
 
+QList<DockArea *> DockContainer::dockAreas() const {
+  Q_D(const DockContainer);
+  return d->dockAreas.values();
+}
+
+QAbstractItemModel *DockContainer::layoutModel() {
+  Q_D(DockContainer);
+  if (!d->layoutModel) {
+    d->layoutModel = new DockLayoutModel(this);
+    d->layoutModel->setContainer(this);
+  }
+  return d->layoutModel;
+}
+
+DockQuickOpenModel *DockContainer::quickOpenModel() {
+  Q_D(DockContainer);
+  if (!d->quickOpenModel) {
+    d->quickOpenModel = new DockQuickOpenModel(this);
+    d->quickOpenModel->setContainer(this);
+  }
+  return d->quickOpenModel;
+}
+
 void DockContainer::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &data) {
   Q_D(DockContainer);
   if (change == QQuickItem::ItemChildAddedChange) {
     auto dw = qobject_cast<DockWidget *>(data.item);
     if (dw) {
       if (isComponentComplete()) {
-        if (!d->dockWidgets.contains(dw))
+        if (!d->dockWidgetIds.contains(dw))
           addDockWidget(dw);
       } else {
         d->initialWidgets.append(dw);
@@ -145,17 +681,32 @@ void DockContainer::itemChange(QQuickItem::ItemChange change, const QQuickItem::
     }
   }
 
+  // focus is followed in whichever window the container is shown in
+  if (change == QQuickItem::ItemSceneChange) {
+    disconnect(d->focusConnection);
+    if (data.window)
+      d->focusConnection =
+          connect(data.window, &QQuickWindow::activeFocusItemChanged, this, &DockContainer::window_activeFocusItemChanged);
+  }
+
   QQuickItem::itemChange(change, data);
 }
 
 void DockContainer::addDockWidget(DockWidget *widget) {
   Q_D(DockContainer);
 
-  widget->setZ(widget->area() == Dock::Float ? Z_WIDGET_FLOAT : Z_WIDGET);
+  if (d->dockWidgetIds.contains(widget))
+    return;
+
+  if (widget->area() == Dock::Float)
+    d->floatingLayer.raise(widget);
+  else
+    widget->setZ(Z_WIDGET);
 
   widget->setDockContainer(this);
   //    widget->setParentItem(this);
   d->dockWidgets.append(widget);
+  registerUniqueId(widget);
 
   connect(widget, &DockWidget::beginMove, this, &DockContainer::dockWidget_beginMove, Qt::QueuedConnection);
 
@@ -165,14 +716,38 @@ void DockContainer::addDockWidget(DockWidget *widget) {
   connect(widget, &DockWidget::opened, this, &DockContainer::dockWidget_opened);
   //    connect(widget, &DockWidget::areaChanged, this, &DockContainer::dockWidget_areaChanged);
   connect(widget, &QQuickItem::visibleChanged, this, &DockContainer::dockWidget_visibleChanged);
+  d->gripLayer->trackDockWidget(widget);
+
+  for (auto signal : {&QQuickItem::xChanged, &QQuickItem::yChanged, &QQuickItem::widthChanged, &QQuickItem::heightChanged,
+                      &QQuickItem::zChanged, &QQuickItem::visibleChanged})
+    connect(widget, signal, d->occlusionTimer, qOverload<>(&QTimer::start));
+  connect(widget, &DockWidget::areaChanged, this, &DockContainer::scheduleAutoSave);
+  connect(widget, &DockWidget::areaChanged, this, [this, widget](Dock::Area area) {
+    if (area == Dock::Detached)
+      recordLayoutChange(DockLayoutHistory::Detach, widget->uniqueId());
+  });
+  for (auto signal : {&QQuickItem::xChanged, &QQuickItem::yChanged, &QQuickItem::widthChanged, &QQuickItem::heightChanged})
+    connect(widget, signal, this, &DockContainer::scheduleAutoSave);
 
-  if (d->enableStateStoring) {
-    QSettings set;
-    QMetaEnum e = QMetaEnum::fromType<Dock::Area>();
-    set.beginGroup(widget->title());
-    if (set.contains("area"))
-      widget->setArea((Dock::Area)e.keyToValue(set.value("area", widget->area()).toString().toLocal8Bit().data()));
+  connect(widget, &DockWidget::isActiveChanged, this, &DockContainer::dockWidget_isActiveChanged);
+  connect(widget, &DockWidget::contentItemChanged, this, [this, widget](QQuickItem *contentItem) {
+    if (!contentItem)
+      forgetContent(widget);
+  });
+  connect(widget, &DockWidget::uniqueIdChanged, this, &DockContainer::dockWidget_uniqueIdChanged);
+
+  connect(widget, &QObject::destroyed, this, [this, widget]() { forgetDockWidget(widget); });
+
+  if (widget->contentLoading() == DockWidget::PreloadWhenIdle && !widget->contentItem()) {
+    d->preloadQueue.append(widget);
+    d->preloadTimer->start();
   }
+
+  // a snapshot applied before this dock existed decides where it goes
+  auto pending = d->pendingLayout.find(widget->uniqueId());
+  if (pending != d->pendingLayout.end() && !pending->closed && d->dockAreas.contains(static_cast<Dock::Area>(pending->area)))
+    widget->setArea(static_cast<Dock::Area>(pending->area));
+
   switch (widget->area()) {
   case Dock::Left:
   case Dock::Right:
@@ -188,14 +763,25 @@ void DockContainer::addDockWidget(DockWidget *widget) {
     d->dockAreas[Dock::Center]->addDockWidget(widget);
     d->dockAreas[Dock::Center]->polish();
     break;
+
+    // adopted from another container in the middle of a drag
+  case Dock::Float:
+  case Dock::Detached:
+    break;
   default:
     qWarning() << "dock has no area " << widget->title();
     break;
   }
 
+  if (pending != d->pendingLayout.end()) {
+    applyWidgetLayout(widget, *pending);
+    d->pendingLayout.erase(pending);
+  }
+
   if (isComponentComplete())
     reorderDockAreas();
 
+  Q_EMIT dockWidgetAdded(widget);
   Q_EMIT dockWidgetsChanged(d->dockWidgets);
 }
 
@@ -205,17 +791,53 @@ void DockContainer::removeDockWidget(DockWidget *widget) {
     widget->dockArea()->removeDockWidget(widget);
   widget->setParentItem(nullptr);
   d->removedDockWidgets.append(widget);
+  scheduleAutoSave();
+  Q_EMIT dockWidgetRemoved(widget);
 }
 
 void DockContainer::reorderDockAreas() {
   Q_D(DockContainer);
 
+  // the layout under a maximized widget is frozen, catch up on restore
+  if (d->maximizedWidget) {
+    d->layoutDirty = true;
+    return;
+  }
+
+  // endBatch() lays out once for the whole batch
+  if (d->batchDepth)
+    return;
+
+  auto rects = areaRects();
+  // auto-hide areas only reserve their tab strip here, expanding them is an
+  // overlay and never comes back to this function
+  for (auto i = rects.constBegin(); i != rects.constEnd(); ++i)
+    d->dockAreas[i.key()]->setLayoutRect(i.value());
+
+  d->gripLayer->updateAreaGrip(d->dockAreas[Dock::Left]);
+  d->gripLayer->updateAreaGrip(d->dockAreas[Dock::Top]);
+  d->gripLayer->updateAreaGrip(d->dockAreas[Dock::Right]);
+  d->gripLayer->updateAreaGrip(d->dockAreas[Dock::Bottom]);
+}
+
+QMap<Dock::Area, QRectF> DockContainer::areaRects(Dock::Area openArea) const {
+  Q_D(const DockContainer);
+
+  // openArea is laid out as if it were open already, that is where a drop into it ends up
+  auto size = [this, d, openArea](Dock::Area area) -> qreal {
+    auto da = d->dockAreas[area];
+    if (area != openArea || da->isOpen())
+      return panelSize(area);
+    return da->autoHide() ? da->stripSize() : da->panelSize();
+  };
+
+  QMap<Dock::Area, QRectF> rects;
   QRectF rc;
 
-  rc.setLeft(panelSize(Dock::Left));
-  rc.setTop(panelSize(Dock::Top));
-  rc.setWidth(width() - panelSize(Dock::Right) - panelSize(Dock::Left));
-  rc.setHeight(height() - panelSize(Dock::Top) - panelSize(Dock::Bottom));
+  rc.setLeft(size(Dock::Left));
+  rc.setTop(size(Dock::Top));
+  rc.setWidth(width() - size(Dock::Right) - size(Dock::Left));
+  rc.setHeight(height() - size(Dock::Top) - size(Dock::Bottom));
 
   qreal leftStart, leftEnd;
   qreal topStart, topEnd;
@@ -253,20 +875,20 @@ void DockContainer::reorderDockAreas() {
     bottomEnd = width();
     rightEnd = rc.bottom();
   }
-  d->dockAreas[Dock::Left]->setPosition(QPointF(0, leftStart));
-  d->dockAreas[Dock::Left]->setSize(QSizeF(rc.left(), leftEnd - leftStart));
-
-  d->dockAreas[Dock::Top]->setPosition(QPointF(topStart, 0));
-  d->dockAreas[Dock::Top]->setSize(QSizeF(topEnd - topStart, rc.top()));
-
-  d->dockAreas[Dock::Right]->setPosition(QPointF(rc.right(), rightStart));
-  d->dockAreas[Dock::Right]->setSize(QSizeF(width() - rc.right(), rightEnd - rightStart));
-
-  d->dockAreas[Dock::Bottom]->setPosition(QPointF(bottomStart, rc.bottom()));
-  d->dockAreas[Dock::Bottom]->setSize(QSizeF(bottomEnd - bottomStart, height() - rc.bottom()));
+  rects.insert(Dock::Left, QRectF(0, leftStart, rc.left(), leftEnd - leftStart));
+  rects.insert(Dock::Top, QRectF(topStart, 0, topEnd - topStart, rc.top()));
+  rects.insert(Dock::Right, QRectF(rc.right(), rightStart, width() - rc.right(), rightEnd - rightStart));
+  rects.insert(Dock::Bottom, QRectF(bottomStart, rc.bottom(), bottomEnd - bottomStart, height() - rc.bottom()));
+  rects.insert(Dock::Center, rc);
+  return rects;
+}
 
-  d->dockAreas[Dock::Center]->setPosition(rc.topLeft());
-  d->dockAreas[Dock::Center]->setSize(rc.size());
+QRectF DockContainer::dropRect(Dock::Area area, int index) const {
+  Q_D(const DockContainer);
+  auto da = d->dockAreas.value(area);
+  if (!da)
+    return QRectF();
+  return da->d_func()->dropRect(areaRects(area).value(area), index);
 }
 
 void DockContainer::setTopLeftOwner(Qt::Edge topLeftOwner) {
@@ -346,77 +968,394 @@ void DockContainer::setEnableStateStoring(bool enableStateStoring) {
   Q_EMIT enableStateStoringChanged(d->enableStateStoring);
 }
 
-void DockContainer::setDefaultDisplayType(Dock::DockWidgetDisplayType defaultDisplayType) {
+void DockContainer::setLayoutFile(const QString &layoutFile) {
   Q_D(DockContainer);
 
-  if (d->defaultDisplayType == defaultDisplayType)
+  if (d->layoutFile == layoutFile)
     return;
 
-  d->defaultDisplayType = defaultDisplayType;
-  Q_EMIT defaultDisplayTypeChanged(d->defaultDisplayType);
+  d->layoutFile = layoutFile;
+  // the next save starts a journal at the new path
+  delete d->journal;
+  d->journal = nullptr;
+  Q_EMIT layoutFileChanged(d->layoutFile);
 }
 
-void DockContainer::dockWidget_beginMove() {
+void DockContainer::setDefaultLayout(const QString &defaultLayout) {
   Q_D(DockContainer);
 
-  auto dw = qobject_cast<DockWidget *>(sender());
-
-  for (auto d : d->dockWidgets)
-    d->setZ(d->z() - 1);
-  dw->setZ(Z_WIDGET_FLOAT);
-
-  if (dw->dockArea()) {
-    //        dw->beginDetach();
-    dw->setArea(Dock::Float);
-    dw->dockArea()->removeDockWidget(dw);
-    dw->restoreSize();
-  }
+  if (d->defaultLayout == defaultLayout)
+    return;
 
-  d->dockMoveGuide->setAllowedAreas(dw->allowedAreas());
-  d->dockMoveGuide->begin(mapToGlobal(QPoint(0, 0)), size());
-  //    d->dockMoveGuide->setSize(size());
-  //    d->dockMoveGuide->setVisible(true);
+  d->defaultLayout = defaultLayout;
+  Q_EMIT defaultLayoutChanged(d->defaultLayout);
 }
 
-void DockContainer::dockWidget_moving(const QPointF &pt) {
-  Q_D(const DockContainer);
-  d->dockMoveGuide->setMousePos(pt);
+void DockContainer::setAutoSave(bool autoSave) {
+  Q_D(DockContainer);
+
+  if (d->autoSave == autoSave)
+    return;
+
+  d->autoSave = autoSave;
+  if (!d->autoSave)
+    d->autoSaveTimer->stop();
+  Q_EMIT autoSaveChanged(d->autoSave);
 }
 
-void DockContainer::dockWidget_moved() {
+void DockContainer::setAutoSaveDelay(int autoSaveDelay) {
+  Q_D(DockContainer);
+
+  if (d->autoSaveDelay == autoSaveDelay)
+    return;
+
+  d->autoSaveDelay = autoSaveDelay;
+  d->autoSaveTimer->setInterval(d->autoSaveDelay);
+  Q_EMIT autoSaveDelayChanged(d->autoSaveDelay);
+}
+
+void DockContainer::setDefaultDisplayType(Dock::DockWidgetDisplayType defaultDisplayType) {
+  Q_D(DockContainer);
+
+  if (d->defaultDisplayType == defaultDisplayType)
+    return;
+
+  d->defaultDisplayType = defaultDisplayType;
+  Q_EMIT defaultDisplayTypeChanged(d->defaultDisplayType);
+}
+
+void DockContainer::maximizeDockWidget(DockWidget *widget) {
+  Q_D(DockContainer);
+
+  if (!widget || widget->dockContainer() != this || d->maximizedWidget == widget)
+    return;
+
+  // a detached dock has a window of its own to maximize
+  if (widget->area() == Dock::Detached || widget->parentItem() != this)
+    return;
+
+  if (d->maximizedWidget)
+    restoreDockWidget();
+
+  collapseAutoHideAreas();
+
+  // a tab that is not the current one was hidden by its area
+  if (auto da = widget->dockArea())
+    da->setCurrentIndex(da->indexOf(widget));
+  widget->setVisible(true);
+
+  d->maximizedWidget = widget;
+  widget->setMaximized(true);
+  d->floatingLayer.remove(widget);
+  widget->setZ(Z_MAXIMIZED);
+  widget->setPosition(QPointF(0, 0));
+  widget->setSize(size());
+
+  if (d->suspendContentOnMaximize)
+    for (auto &dw : d->dockWidgets) {
+      auto content = dw->contentItem();
+      if (dw == widget || dw->area() == Dock::Detached || !content || !content->isVisible())
+        continue;
+      content->setVisible(false);
+      d->suspendedContents.append(content);
+    }
+
+  d->occlusionTimer->start();
+  Q_EMIT maximizedDockWidgetChanged(widget);
+}
+
+void DockContainer::restoreDockWidget() {
+  Q_D(DockContainer);
+
+  if (!d->maximizedWidget)
+    return;
+
+  auto widget = d->maximizedWidget;
+  d->maximizedWidget = nullptr;
+  d->occlusionTimer->start();
+
+  for (auto &content : d->suspendedContents)
+    if (content)
+      content->setVisible(true);
+  d->suspendedContents.clear();
+
+  widget->setMaximized(false);
+  if (widget->area() == Dock::Float)
+    d->floatingLayer.raise(widget);
+
+  if (d->layoutDirty) {
+    d->layoutDirty = false;
+    reorderDockAreas();
+  }
+  // also hides it again if its area is a collapsed auto-hide strip
+  if (widget->dockArea())
+    widget->dockArea()->polish();
+
+  Q_EMIT maximizedDockWidgetChanged(nullptr);
+}
+
+void DockContainer::setContentBudget(qint64 contentBudget) {
+  Q_D(DockContainer);
+  if (d->contentBudget == contentBudget)
+    return;
+
+  d->contentBudget = contentBudget;
+  applyContentBudget();
+  Q_EMIT contentBudgetChanged(d->contentBudget);
+}
+
+void DockContainer::setContentBudgetMode(ContentBudgetMode contentBudgetMode) {
+  Q_D(DockContainer);
+  if (d->contentBudgetMode == contentBudgetMode)
+    return;
+
+  d->contentBudgetMode = contentBudgetMode;
+
+  // the only place every cost is counted again, the unit changed
+  d->contentUsed = 0;
+  for (auto i = d->contentCosts.begin(); i != d->contentCosts.end(); ++i) {
+    i.value() = contentCost(i.key());
+    d->contentUsed += i.value();
+  }
+  applyContentBudget();
+  Q_EMIT contentBudgetModeChanged(d->contentBudgetMode);
+}
+
+void DockContainer::setPrewarmCount(int prewarmCount) {
+  Q_D(DockContainer);
+  if (d->prewarmCount == prewarmCount)
+    return;
+
+  d->prewarmCount = prewarmCount;
+  prewarmRecentContent();
+  Q_EMIT prewarmCountChanged(d->prewarmCount);
+}
+
+void DockContainer::setSnapDistance(qreal snapDistance) {
+  Q_D(DockContainer);
+  if (qFuzzyCompare(d->floatingLayer.snapDistance(), snapDistance))
+    return;
+
+  d->floatingLayer.setSnapDistance(snapDistance);
+  Q_EMIT snapDistanceChanged(snapDistance);
+}
+
+void DockContainer::setIncubationBudget(int incubationBudget) {
+  Q_D(DockContainer);
+  if (d->incubationBudget == incubationBudget)
+    return;
+
+  d->incubationBudget = incubationBudget;
+  if (d->incubationController && d->incubationBudget <= 0) {
+    DockIncubationController::uninstall(qmlEngine(this));
+    d->incubationController = nullptr;
+  } else if (d->incubationController) {
+    d->incubationController->setBudget(d->incubationBudget);
+  }
+  Q_EMIT incubationBudgetChanged(d->incubationBudget);
+}
+
+void DockContainer::setSuspendContentOnMaximize(bool suspendContentOnMaximize) {
+  Q_D(DockContainer);
+
+  if (d->suspendContentOnMaximize == suspendContentOnMaximize)
+    return;
+
+  d->suspendContentOnMaximize = suspendContentOnMaximize;
+  Q_EMIT suspendContentOnMaximizeChanged(d->suspendContentOnMaximize);
+}
+
+void DockContainer::dockWidget_beginMove() {
   Q_D(DockContainer);
-  d->dockMoveGuide->end();
+
+  auto dw = qobject_cast<DockWidget *>(sender());
+  if (dw == d->maximizedWidget)
+    restoreDockWidget();
+
+  d->floatingLayer.raise(dw);
+
+  if (dw->dockArea()) {
+    //        dw->beginDetach();
+    dw->setArea(Dock::Float);
+    dw->dockArea()->removeDockWidget(dw);
+    dw->restoreSize();
+  }
+
+  d->floatingLayer.beginSnap(dw, d->dockWidgets, QRectF(0, 0, width(), height()));
+
+  // the session shows the guide of whichever container the mouse is over
+  DockDragSession::instance()->begin(dw, this);
+}
+
+void DockContainer::dockWidget_moving(const QPointF &globalPos) {
+  DockDragSession::instance()->move(globalPos);
+}
+
+void DockContainer::applyDragPosition(DockWidget *dw) {
+  Q_D(DockContainer);
+
+  auto wd = dw->d_func();
+  if (!wd->dragPosPending)
+    return;
+  wd->dragPosPending = false;
+
+  if (wd->area == Dock::Detached) {
+    if (wd->dockWindow)
+      wd->dockWindow->setPosition(wd->dragPos.toPoint());
+    return;
+  }
+
+  auto pos = wd->dragPos;
+  if (wd->area == Dock::Float && dw->parentItem() == this)
+    pos = d->floatingLayer.snap(QRectF(pos, dw->size()));
+  dw->setPosition(pos);
+}
+
+void DockContainer::dockWidget_moved() {
+  auto target = DockDragSession::instance()->end();
 
   auto dw = qobject_cast<DockWidget *>(sender());
   if (!dw)
     return;
 
-  switch (d->dockMoveGuide->area()) {
+  // outside every container the dock goes to a window of its own
+  if (!target) {
+    dropDockWidget(dw, Dock::Detached);
+    return;
+  }
+
+  if (target != this)
+    target->adoptDockWidget(dw);
+  target->dropDockWidget(dw, target->d_func()->dockMoveGuide->area());
+}
+
+void DockContainer::dropDockWidget(DockWidget *dw, Dock::Area dropArea) {
+  Q_D(DockContainer);
+
+  switch (dropArea) {
   case Dock::Left:
   case Dock::Right:
   case Dock::Top:
   case Dock::Bottom:
-  case Dock::Center:
-    if (dw->dockArea() != d->dockAreas[d->dockMoveGuide->area()]) {
-      d->dockAreas[d->dockMoveGuide->area()]->addDockWidget(dw);
+  case Dock::Center: {
+    auto area = d->dockAreas[dropArea];
+    if (dw->dockArea() != area) {
+      area->addDockWidget(dw);
     }
-    dw->setZ(Z_WIDGET);
+    // dropped on a split boundary or a tab edge rather than on a button
+    auto index = d->dockMoveGuide->insertIndex();
+    if (index >= 0 && d->dockMoveGuide->dockArea() == area)
+      area->moveDockWidget(area->indexOf(dw), qMin(index, area->dockWidgets().count() - 1));
+    d->floatingLayer.remove(dw);
+    dw->setZ(area->expanded() ? Z_OVERLAY + 1 : Z_WIDGET);
     reorderDockAreas();
     break;
+  }
   case Dock::Float:
   case Dock::Detached:
-    dw->setArea(d->dockMoveGuide->area());
+    dw->setArea(dropArea);
+    if (dropArea == Dock::Detached)
+      d->floatingLayer.remove(dw);
     break;
 
   default:
     break;
   }
+
+  recordLayoutChange(DockLayoutHistory::Move, dw->uniqueId());
+}
+
+void DockContainer::adoptDockWidget(DockWidget *widget) {
+  auto source = widget->dockContainer();
+  if (source == this)
+    return;
+
+  // the item moves over as it is, its content is not created again
+  auto globalPos = widget->mapToGlobal(QPointF(0, 0));
+  if (source)
+    source->releaseDockWidget(widget);
+
+  addDockWidget(widget);
+
+  // addDockWidget() parents the item to this container
+  if (widget->area() == Dock::Detached)
+    widget->dockWindow()->setDockWidget(widget);
+  else
+    widget->setPosition(mapFromGlobal(globalPos));
+}
+
+void DockContainer::releaseDockWidget(DockWidget *widget) {
+  Q_D(DockContainer);
+  if (!d->dockWidgetIds.contains(widget))
+    return;
+
+  if (widget == d->maximizedWidget)
+    restoreDockWidget();
+  if (widget->dockArea())
+    widget->dockArea()->removeDockWidget(widget);
+
+  disconnect(widget, nullptr, this, nullptr);
+  disconnect(widget, nullptr, d->occlusionTimer, nullptr);
+  d->gripLayer->untrackDockWidget(widget);
+  d->preloadQueue.removeAll(widget);
+  d->incubationQueue.removeAll(widget);
+  forgetDockWidget(widget);
+
+  scheduleAutoSave();
+  Q_EMIT dockWidgetRemoved(widget);
+  Q_EMIT dockWidgetsChanged(d->dockWidgets);
+}
+
+void DockContainer::forgetDockWidget(DockWidget *widget) {
+  Q_D(DockContainer);
+  d->dockWidgetsById.remove(d->dockWidgetIds.take(widget));
+  d->dockWidgets.removeOne(widget);
+  if (d->activeDockWidget == widget) {
+    d->activeDockWidget = nullptr;
+    Q_EMIT activeDockWidgetChanged(nullptr);
+  }
+  forgetContent(widget);
+  d->floatingLayer.remove(widget);
+  if (d->activationRecency.remove(widget)) {
+    d->recentList.clear();
+    Q_EMIT recentDockWidgetsChanged();
+  }
+  if (!d->incubatingWidget || d->incubatingWidget == widget)
+    QMetaObject::invokeMethod(this, &DockContainer::startNextIncubation, Qt::QueuedConnection);
+}
+
+QList<DockContainer *> DockContainer::containers() {
+  return *containerRegistry();
+}
+
+bool DockContainer::containsGlobal(DockContainer *container, const QPointF &globalPos) {
+  if (!container->isVisible() || !container->window() || !container->window()->isVisible())
+    return false;
+  return QRectF(container->mapToGlobal(QPointF(0, 0)), container->size()).contains(globalPos);
+}
+
+DockContainer *DockContainer::containerAt(const QPointF &globalPos, DockContainer *preferred) {
+  if (preferred && containsGlobal(preferred, globalPos))
+    return preferred;
+
+  // window stacking is not known, the focused window is the best guess for the top one
+  DockContainer *found = nullptr;
+  for (auto container : *containerRegistry()) {
+    if (!containsGlobal(container, globalPos))
+      continue;
+    if (container->window() == QGuiApplication::focusWindow())
+      return container;
+    if (!found)
+      found = container;
+  }
+  return found;
 }
 
 void DockContainer::dockWidget_opened() {
   Q_D(DockContainer);
   auto widget = qobject_cast<DockWidget *>(sender());
 
+  widget->d_func()->isClosed = false;
   widget->setParentItem(this);
   switch (widget->area()) {
   case Dock::Left:
@@ -437,12 +1376,19 @@ void DockContainer::dockWidget_opened() {
     break;
   }
   widget->setVisible(true);
+  recordLayoutChange(DockLayoutHistory::Open, widget->uniqueId());
 }
 
 void DockContainer::dockWidget_closed() {
+  Q_D(DockContainer);
   auto w = qobject_cast<DockWidget *>(sender());
-  if (w)
+  if (w && w == d->maximizedWidget)
+    restoreDockWidget();
+  if (w) {
+    w->d_func()->isClosed = true;
     w->setParentItem(nullptr);
+    recordLayoutChange(DockLayoutHistory::Close, w->uniqueId());
+  }
 
   //        removeDockWidget(w);
 }
@@ -457,9 +1403,10 @@ void DockContainer::dockWidget_visibleChanged() {
   if (dw->area() == Dock::Float)
     return;
 
+  // tabs and collapsed auto-hide panels hide their docks themselves
   if (dw->dockArea()) {
-    auto dt = dw->dockArea()->displayType();
-    if (dt == Dock::TabbedView)
+    auto dt = dw->dockArea()->effectiveDisplayType();
+    if (dt == Dock::TabbedView || dt == Dock::StackedView)
       return;
   }
 
@@ -485,7 +1432,379 @@ void DockContainer::dockWidget_areaChanged(Dock::Area area) {
     d->dockAreas[area]->addDockWidget(dw);
 }
 
+void DockContainer::dockArea_expandedChanged(bool expanded) {
+  Q_D(DockContainer);
+  auto da = qobject_cast<DockArea *>(sender());
+  if (!da)
+    return;
+
+  da->setZ(expanded ? Z_OVERLAY : Z_GROUP);
+  for (auto &dw : da->dockWidgets())
+    dw->setZ(expanded ? Z_OVERLAY + 1 : Z_WIDGET);
+
+  if (expanded)
+    d->gripLayer->addOccluder(da);
+  else
+    d->gripLayer->removeOccluder(da);
+  d->gripLayer->updateAreaGrip(da);
+  d->occlusionTimer->start();
+}
+
+void DockContainer::preloadNextContent() {
+  Q_D(DockContainer);
+
+  // One widget per event loop pass, so preloading never blocks a frame for long
+  while (!d->preloadQueue.isEmpty()) {
+    auto dw = d->preloadQueue.takeFirst();
+    if (dw && !dw->contentItem()) {
+      dw->loadContent();
+      break;
+    }
+  }
+
+  if (!d->preloadQueue.isEmpty())
+    d->preloadTimer->start();
+}
+
+void DockContainer::touchContent(DockWidget *widget) {
+  Q_D(DockContainer);
+  d->contentRecency.touch(widget);
+
+  // counted at the size it is shown with now
+  auto cost = contentCost(widget);
+  d->contentUsed += cost - d->contentCosts.value(widget);
+  d->contentCosts.insert(widget, cost);
+
+  applyContentBudget();
+}
+
+void DockContainer::forgetContent(DockWidget *widget) {
+  Q_D(DockContainer);
+  d->contentRecency.remove(widget);
+  d->contentUsed -= d->contentCosts.take(widget);
+}
+
+qint64 DockContainer::contentCost(DockWidget *widget) const {
+  Q_D(const DockContainer);
+  auto item = widget->contentItem();
+  if (!item)
+    return 0;
+
+  if (d->contentBudgetMode == ItemCount)
+    return 1;
+
+  // Rough estimate: one 32bit texture of the content size
+  return qMax<qint64>(1, qint64(item->width()) * qint64(item->height()) * 4);
+}
+
+void DockContainer::applyContentBudget() {
+  Q_D(DockContainer);
+  if (d->contentBudget <= 0)
+    return;
+
+  auto used = d->contentUsed;
+  auto recent = recentDockWidgets(d->prewarmCount);
+  QSet<DockWidget *> keepAlive(recent.begin(), recent.end());
+
+  QList<DockWidget *> victims;
+  for (auto i = d->contentRecency.rbegin(); i != d->contentRecency.rend() && used > d->contentBudget; ++i) {
+    auto dw = *i;
+    if (!dw->contentItem() || dw->d_func()->isShown() || keepAlive.contains(dw))
+      continue;
+    used -= d->contentCosts.value(dw);
+    victims.append(dw);
+  }
+
+  // an unloaded content leaves the accounting through contentItemChanged
+  for (auto &dw : victims)
+    dw->unloadContent();
+}
+
+QString DockContainer::makeUniqueId(const QString &base) const {
+  Q_D(const DockContainer);
+  auto id = base.isEmpty() ? QStringLiteral("dock") : base;
+  if (!d->dockWidgetsById.contains(id))
+    return id;
+
+  for (int n = 2;; ++n) {
+    auto candidate = QStringLiteral("%1#%2").arg(id).arg(n);
+    if (!d->dockWidgetsById.contains(candidate))
+      return candidate;
+  }
+}
+
+void DockContainer::registerUniqueId(DockWidget *widget) {
+  Q_D(DockContainer);
+  auto oldId = d->dockWidgetIds.value(widget);
+  auto id = widget->uniqueId();
+
+  if (d->dockWidgetIds.contains(widget) && oldId == id)
+    return;
+
+  d->dockWidgetsById.remove(oldId);
+
+  // Titles are not unique, so ids derived from them get a suffix
+  if (id.isEmpty()) {
+    id = makeUniqueId(widget->title());
+  } else if (d->dockWidgetsById.contains(id)) {
+    qWarning() << "Duplicate dock uniqueId" << id;
+    id = makeUniqueId(id);
+  }
+
+  d->dockWidgetsById.insert(id, widget);
+  d->dockWidgetIds.insert(widget, id);
+  widget->setUniqueId(id);
+}
+
+void DockContainer::dockWidget_uniqueIdChanged() {
+  auto dw = qobject_cast<DockWidget *>(sender());
+  if (dw)
+    registerUniqueId(dw);
+}
+
+DockWidget *DockContainer::findDockWidget(const QString &uniqueId) const {
+  Q_D(const DockContainer);
+  return d->dockWidgetsById.value(uniqueId);
+}
+
+DockArea *DockContainer::dockAreaOf(const QString &uniqueId) const {
+  auto dw = findDockWidget(uniqueId);
+  return dw ? dw->dockArea() : nullptr;
+}
+
+int DockContainer::tabIndexOf(const QString &uniqueId) const {
+  auto dw = findDockWidget(uniqueId);
+  return dw && dw->dockArea() ? dw->dockArea()->indexOf(dw) : -1;
+}
+
+void DockContainer::window_activeFocusItemChanged() {
+  if (!window())
+    return;
+
+  // The owner is cached on the focus item, so this is not a parent walk per event
+  auto dw = DockWidgetAttached::findOwner(window()->activeFocusItem());
+  if (dw && dw->dockContainer() == this)
+    setActiveDockWidget(dw);
+}
+
+void DockContainer::setActiveDockWidget(DockWidget *widget) {
+  Q_D(DockContainer);
+  if (d->activeDockWidget == widget)
+    return;
+
+  // set before toggling, dockWidget_isActiveChanged() sees the new owner
+  auto previous = d->activeDockWidget;
+  d->activeDockWidget = widget;
+  if (previous)
+    previous->setIsActive(false);
+  if (d->activeDockWidget)
+    d->activeDockWidget->setIsActive(true);
+
+  Q_EMIT activeDockWidgetChanged(d->activeDockWidget);
+}
+
+void DockContainer::dockWidget_isActiveChanged(bool isActive) {
+  Q_D(DockContainer);
+  auto dw = qobject_cast<DockWidget *>(sender());
+  if (!dw)
+    return;
+
+  // isActive written from QML goes through the container too, one dock is active
+  if (!isActive) {
+    if (dw == d->activeDockWidget)
+      setActiveDockWidget(nullptr);
+    return;
+  }
+  if (dw != d->activeDockWidget)
+    setActiveDockWidget(dw);
+
+  if (dw->area() == Dock::Float && dw != d->maximizedWidget && d->floatingLayer.top() != dw)
+    d->floatingLayer.raise(dw);
+
+  if (d->activationRecency.first() == dw)
+    return;
+
+  d->activationRecency.touch(dw);
+  d->recentList.clear();
+  prewarmRecentContent();
+  Q_EMIT recentDockWidgetsChanged();
+}
+
+void DockContainer::prewarmRecentContent() {
+  Q_D(DockContainer);
+  if (d->prewarmCount <= 0)
+    return;
+
+  // Queued on the idle preload timer, loaded one per event loop pass
+  for (auto &dw : recentDockWidgets(d->prewarmCount)) {
+    if (dw->contentItem() || dw->isContentLoading() || d->preloadQueue.contains(dw))
+      continue;
+    d->preloadQueue.append(dw);
+  }
+
+  if (!d->preloadQueue.isEmpty())
+    d->preloadTimer->start();
+}
+
+QList<DockWidget *> DockContainer::recentDockWidgets(int count) const {
+  Q_D(const DockContainer);
+  if (count < 0)
+    return recentList();
+
+  // the few most recent are read right after each activation, no flattening
+  QList<DockWidget *> list;
+  list.reserve(qMin(count, d->activationRecency.size()));
+  for (auto i = d->activationRecency.begin(); i != d->activationRecency.end() && list.size() < count; ++i)
+    list.append(*i);
+  return list;
+}
+
+DockWidget *DockContainer::recentDockWidget(int index) const {
+  return recentList().value(index);
+}
+
+const QList<DockWidget *> &DockContainer::recentList() const {
+  Q_D(const DockContainer);
+  // flattened once per change, QML views index it on every row
+  if (d->recentList.isEmpty() && !d->activationRecency.isEmpty())
+    d->recentList = QList<DockWidget *>(d->activationRecency.begin(), d->activationRecency.end());
+  return d->recentList;
+}
+
+QVariantMap DockContainer::dragStatistics() const {
+  // of the running drag, or the last one in any container; latencies are in microseconds
+  auto session = DockDragSession::instance();
+  return {{"events", session->events()},
+          {"updates", session->updates()},
+          {"averageLatency", session->averageLatency()},
+          {"maxLatency", session->maxLatency()}};
+}
+
+void DockContainer::activateDockWidget(DockWidget *widget) {
+  if (!widget || widget->dockContainer() != this)
+    return;
+
+  auto da = widget->dockArea();
+  if (!da) {
+    setActiveDockWidget(widget);
+    return;
+  }
+
+  if (da->autoHide())
+    da->setExpanded(true);
+  da->setCurrentIndex(da->indexOf(widget));
+  setActiveDockWidget(widget);
+  widget->forceActiveFocus();
+}
+
+void DockContainer::updateOcclusion() {
+  Q_D(DockContainer);
+
+  // detached docks live in windows of their own, nothing here covers them
+  auto inContainer = [this](DockWidget *dw) { return dw->area() != Dock::Detached && dw->parentItem() == this; };
+
+  // everything drawn above the docks in container coordinates
+  QList<QPair<QRectF, qreal>> occluders;
+  for (auto &dw : d->dockWidgets)
+    if (dw->area() == Dock::Float && dw->isVisible() && inContainer(dw))
+      occluders.append({QRectF(dw->position(), dw->size()), dw->z()});
+  for (auto &da : d->dockAreas)
+    if (da->expanded() && da->isVisible())
+      occluders.append({QRectF(da->position(), da->size()), da->z()});
+
+  auto maximized = d->maximizedWidget && inContainer(d->maximizedWidget) ? d->maximizedWidget : nullptr;
+
+  for (auto &dw : d->dockWidgets) {
+    if (!inContainer(dw)) {
+      dw->d_func()->setOccluded(false);
+      continue;
+    }
+
+    auto occluded = maximized && maximized != dw;
+
+    if (!occluded) {
+      QRectF rc(dw->position(), dw->size());
+      for (auto &o : occluders)
+        if (o.second > dw->z() && o.first.contains(rc)) {
+          occluded = true;
+          break;
+        }
+    }
+
+    dw->d_func()->setOccluded(occluded);
+  }
+}
+
+void DockContainer::queueIncubation(DockWidget *widget) {
+  Q_D(DockContainer);
+  if (d->incubatingWidget == widget)
+    return;
+
+  d->incubationQueue.removeOne(widget);
+  // The dock the user is looking at goes first, preloads wait their turn
+  if (widget->d_func()->isShown())
+    d->incubationQueue.prepend(widget);
+  else
+    d->incubationQueue.append(widget);
+
+  if (!d->incubatingWidget)
+    startNextIncubation();
+}
+
+void DockContainer::incubationFinished(DockWidget *widget) {
+  Q_D(DockContainer);
+  d->incubationQueue.removeOne(widget);
+  if (d->incubatingWidget == widget) {
+    d->incubatingWidget = nullptr;
+    startNextIncubation();
+  }
+}
+
+void DockContainer::startNextIncubation() {
+  Q_D(DockContainer);
+  if (d->incubatingWidget)
+    return;
+
+  if (!d->incubationController && d->incubationBudget > 0) {
+    d->incubationController = DockIncubationController::install(qmlEngine(this));
+    if (d->incubationController)
+      d->incubationController->setBudget(d->incubationBudget);
+  }
+
+  while (!d->incubationQueue.isEmpty()) {
+    auto dw = d->incubationQueue.takeFirst();
+    if (!dw || !dw->isContentLoading())
+      continue;
+
+    dw->d_func()->startIncubation();
+    if (dw->d_func()->incubator) {
+      d->incubatingWidget = dw;
+      break;
+    }
+  }
+}
+
+void DockContainer::collapseAutoHideAreas(QQuickItem *except) {
+  Q_D(DockContainer);
+
+  for (auto &da : d->dockAreas) {
+    if (!da->expanded())
+      continue;
+
+    if (except) {
+      auto dw = DockWidgetAttached::findOwner(except);
+      if ((dw && dw->dockArea() == da) || Dock::findInParents<DockArea>(except) == da)
+        continue;
+    }
+    da->setExpanded(false);
+  }
+}
+
 void DockContainer::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) {
+  Q_D(DockContainer);
+  if (d->maximizedWidget)
+    d->maximizedWidget->setSize(newGeometry.size());
+  d->gripLayer->setSize(newGeometry.size());
   if (isComponentComplete())
     reorderDockAreas();
   QQuickItem::geometryChange(newGeometry, oldGeometry);
@@ -493,7 +1812,10 @@ void DockContainer::geometryChange(const QRectF &newGeometry, const QRectF &oldG
 
 int DockContainer::panelSize(Dock::Area area) const {
   Q_D(const DockContainer);
-  return d->dockAreas[area]->isOpen() ? d->dockAreas[area]->panelSize() : 0.;
+  auto da = d->dockAreas[area];
+  if (!da->isOpen())
+    return 0;
+  return da->autoHide() ? da->stripSize() : da->panelSize();
 }
 
 DockArea *DockContainer::createGroup(Dock::Area area, DockArea *item) {
@@ -583,12 +1905,79 @@ bool DockContainer::enableStateStoring() const {
   return d->enableStateStoring;
 }
 
+QString DockContainer::layoutFile() const {
+  Q_D(const DockContainer);
+  return d->layoutFile;
+}
+
+QString DockContainer::defaultLayout() const {
+  Q_D(const DockContainer);
+  return d->defaultLayout;
+}
+
+bool DockContainer::autoSave() const {
+  Q_D(const DockContainer);
+  return d->autoSave;
+}
+
+int DockContainer::autoSaveDelay() const {
+  Q_D(const DockContainer);
+  return d->autoSaveDelay;
+}
+
 Dock::DockWidgetDisplayType DockContainer::defaultDisplayType() const {
   Q_D(const DockContainer);
   return d->defaultDisplayType;
 }
 
+DockGripLayer *DockContainer::gripLayer() const {
+  Q_D(const DockContainer);
+  return d->gripLayer;
+}
+
+DockWidget *DockContainer::activeDockWidget() const {
+  Q_D(const DockContainer);
+  return d->activeDockWidget;
+}
+
+DockWidget *DockContainer::maximizedDockWidget() const {
+  Q_D(const DockContainer);
+  return d->maximizedWidget;
+}
+
+qint64 DockContainer::contentBudget() const {
+  Q_D(const DockContainer);
+  return d->contentBudget;
+}
+
+DockContainer::ContentBudgetMode DockContainer::contentBudgetMode() const {
+  Q_D(const DockContainer);
+  return d->contentBudgetMode;
+}
+
+int DockContainer::prewarmCount() const {
+  Q_D(const DockContainer);
+  return d->prewarmCount;
+}
+
+qreal DockContainer::snapDistance() const {
+  Q_D(const DockContainer);
+  return d->floatingLayer.snapDistance();
+}
+
+int DockContainer::incubationBudget() const {
+  Q_D(const DockContainer);
+  return d->incubationBudget;
+}
+
+bool DockContainer::suspendContentOnMaximize() const {
+  Q_D(const DockContainer);
+  return d->suspendContentOnMaximize;
+}
+
 bool DockContainer::childMouseEventFilter(QQuickItem *item, QEvent *event) {
+  if (event->type() == QEvent::MouseButtonPress)
+    collapseAutoHideAreas(item);
 
   auto handler = qobject_cast<DockWidgetMoveHandler *>(item);
   if (handler) {
@@ -2,13 +2,21 @@
 #define DOCKCONTAINER_H
 
 #include "dock.h"
+#include "docklayoutsnapshot.h"
 
+#include <QMap>
 #include <QQuickPaintedItem>
+#include <QVariantMap>
 
 class DockWidget;
 class DockMoveGuide;
 class DockArea;
 class DockAreaResizeHandler;
+class DockGripLayer;
+class DockLayoutJournal;
+class DockLayoutModel;
+class DockQuickOpenModel;
+class QAbstractItemModel;
 class DockContainerPrivate;
 
 class DockContainer : public QQuickPaintedItem {
@@ -17,33 +25,114 @@ class DockContainer : public QQuickPaintedItem {
   DockContainerPrivate *d_ptr;
 
   Q_PROPERTY(QList<DockWidget *> dockWidgets READ dockWidgets NOTIFY dockWidgetsChanged)
+  Q_PROPERTY(QAbstractItemModel *layoutModel READ layoutModel CONSTANT)
+  Q_PROPERTY(DockQuickOpenModel *quickOpenModel READ quickOpenModel CONSTANT)
   Q_PROPERTY(Qt::Edge topLeftOwner READ topLeftOwner WRITE setTopLeftOwner NOTIFY topLeftOwnerChanged)
   Q_PROPERTY(Qt::Edge topRightOwner READ topRightOwner WRITE setTopRightOwner NOTIFY topRightOwnerChanged)
   Q_PROPERTY(Qt::Edge bottomLeftOwner READ bottomLeftOwner WRITE setBottomLeftOwner NOTIFY bottomLeftOwnerChanged)
   Q_PROPERTY(Qt::Edge bottomRightOwner READ bottomRightOwner WRITE setBottomRightOwner NOTIFY bottomRightOwnerChanged)
   Q_PROPERTY(bool enableStateStoring READ enableStateStoring WRITE setEnableStateStoring NOTIFY enableStateStoringChanged)
+  Q_PROPERTY(QString layoutFile READ layoutFile WRITE setLayoutFile NOTIFY layoutFileChanged)
+  Q_PROPERTY(QString defaultLayout READ defaultLayout WRITE setDefaultLayout NOTIFY defaultLayoutChanged)
+  Q_PROPERTY(bool autoSave READ autoSave WRITE setAutoSave NOTIFY autoSaveChanged)
+  Q_PROPERTY(int autoSaveDelay READ autoSaveDelay WRITE setAutoSaveDelay NOTIFY autoSaveDelayChanged)
+  Q_PROPERTY(QStringList perspectives READ perspectives NOTIFY perspectivesChanged)
+  Q_PROPERTY(QString currentPerspective READ currentPerspective NOTIFY currentPerspectiveChanged)
+  Q_PROPERTY(bool canUndo READ canUndo NOTIFY historyChanged)
+  Q_PROPERTY(bool canRedo READ canRedo NOTIFY historyChanged)
+  Q_PROPERTY(int undoLimit READ undoLimit WRITE setUndoLimit NOTIFY undoLimitChanged)
   Q_PROPERTY(Dock::DockWidgetDisplayType defaultDisplayType READ defaultDisplayType WRITE setDefaultDisplayType NOTIFY
                  defaultDisplayTypeChanged)
+  Q_PROPERTY(DockWidget *maximizedDockWidget READ maximizedDockWidget NOTIFY maximizedDockWidgetChanged)
+  Q_PROPERTY(DockWidget *activeDockWidget READ activeDockWidget NOTIFY activeDockWidgetChanged)
+  Q_PROPERTY(bool suspendContentOnMaximize READ suspendContentOnMaximize WRITE setSuspendContentOnMaximize NOTIFY
+                 suspendContentOnMaximizeChanged)
+  Q_PROPERTY(qint64 contentBudget READ contentBudget WRITE setContentBudget NOTIFY contentBudgetChanged)
+  Q_PROPERTY(ContentBudgetMode contentBudgetMode READ contentBudgetMode WRITE setContentBudgetMode NOTIFY
+                 contentBudgetModeChanged)
+  // milliseconds of QML incubation per 16 ms tick; 0 keeps the window's frame
+  // synced controller. Above 0 the engine wide controller is replaced, which
+  // also paces every asynchronous Loader and Incubator of the application.
+  Q_PROPERTY(int incubationBudget READ incubationBudget WRITE setIncubationBudget NOTIFY incubationBudgetChanged)
+  Q_PROPERTY(int prewarmCount READ prewarmCount WRITE setPrewarmCount NOTIFY prewarmCountChanged)
+  Q_PROPERTY(qreal snapDistance READ snapDistance WRITE setSnapDistance NOTIFY snapDistanceChanged)
 
 public:
+  // EstimatedBytes counts one 32 bit texture of the size a content is shown
+  // with. Images, models and offscreen layers it holds are not seen, so the
+  // budget is a bound on what is on screen rather than on memory.
+  enum ContentBudgetMode { ItemCount, EstimatedBytes };
+  Q_ENUM(ContentBudgetMode)
+
   DockContainer(QQuickItem *parent = nullptr);
   virtual ~DockContainer();
 
   void paint(QPainter *painter) override;
 
   QList<DockWidget *> dockWidgets() const;
+  QList<DockArea *> dockAreas() const;
+  QAbstractItemModel *layoutModel();
+  DockQuickOpenModel *quickOpenModel();
+
+  DockLayoutSnapshot saveLayout() const;
+  void applyLayout(const DockLayoutSnapshot &snapshot);
+  Q_INVOKABLE QByteArray saveState() const;
+  Q_INVOKABLE bool restoreState(const QByteArray &state);
+
+  QStringList perspectives() const;
+  QString currentPerspective() const;
+  Q_INVOKABLE void savePerspective(const QString &name);
+  Q_INVOKABLE bool switchPerspective(const QString &name);
+  Q_INVOKABLE void removePerspective(const QString &name);
+
+  bool canUndo() const;
+  bool canRedo() const;
+  int undoLimit() const;
+
+  Q_INVOKABLE DockWidget *findDockWidget(const QString &uniqueId) const;
+  Q_INVOKABLE DockArea *dockAreaOf(const QString &uniqueId) const;
+  Q_INVOKABLE int tabIndexOf(const QString &uniqueId) const;
+
+  Q_INVOKABLE QList<DockWidget *> recentDockWidgets(int count = -1) const;
+  Q_INVOKABLE DockWidget *recentDockWidget(int index) const;
+
+  Q_INVOKABLE QVariantMap dragStatistics() const;
+
+  static QList<DockContainer *> containers();
+  static DockContainer *containerAt(const QPointF &globalPos, DockContainer *preferred = nullptr);
+  static bool containsGlobal(DockContainer *container, const QPointF &globalPos);
 
 Q_SIGNALS:
   void dockWidgetsChanged(QList<DockWidget *> dockWidgets);
+  void dockWidgetAdded(DockWidget *widget);
+  void dockWidgetRemoved(DockWidget *widget);
   void topLeftOwnerChanged(Qt::Edge topLeftOwner);
   void topRightOwnerChanged(Qt::Edge topRightOwner);
   void bottomLeftOwnerChanged(Qt::Edge bottomLeftOwner);
   void bottomRightOwnerChanged(Qt::Edge bottomRightOwner);
 
   void enableStateStoringChanged(bool enableStateStoring);
+  void layoutFileChanged(const QString &layoutFile);
+  void defaultLayoutChanged(const QString &defaultLayout);
+  void autoSaveChanged(bool autoSave);
+  void autoSaveDelayChanged(int autoSaveDelay);
+  void perspectivesChanged();
+  void currentPerspectiveChanged(const QString &currentPerspective);
+  void historyChanged();
+  void undoLimitChanged(int undoLimit);
 
   void defaultDisplayTypeChanged(Dock::DockWidgetDisplayType defaultDisplayType);
 
+  void maximizedDockWidgetChanged(DockWidget *maximizedDockWidget);
+  void activeDockWidgetChanged(DockWidget *activeDockWidget);
+  void suspendContentOnMaximizeChanged(bool suspendContentOnMaximize);
+  void contentBudgetChanged(qint64 contentBudget);
+  void contentBudgetModeChanged(ContentBudgetMode contentBudgetMode);
+  void incubationBudgetChanged(int incubationBudget);
+  void prewarmCountChanged(int prewarmCount);
+  void snapDistanceChanged(qreal snapDistance);
+  void recentDockWidgetsChanged();
+
 protected:
   void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
   void itemChange(ItemChange, const ItemChangeData &) override;
@@ -63,22 +152,83 @@ public Q_SLOTS:
   void setBottomRightOwner(Qt::Edge bottomRightOwner);
 
   void setEnableStateStoring(bool enableStateStoring);
+  void setLayoutFile(const QString &layoutFile);
+  void setDefaultLayout(const QString &defaultLayout);
+  void setAutoSave(bool autoSave);
+  void setAutoSaveDelay(int autoSaveDelay);
 
   void setDefaultDisplayType(Dock::DockWidgetDisplayType defaultDisplayType);
 
+  void maximizeDockWidget(DockWidget *widget);
+  void restoreDockWidget();
+  void setSuspendContentOnMaximize(bool suspendContentOnMaximize);
+  void setContentBudget(qint64 contentBudget);
+  void setContentBudgetMode(ContentBudgetMode contentBudgetMode);
+  void applyContentBudget();
+  void setIncubationBudget(int incubationBudget);
+  void setPrewarmCount(int prewarmCount);
+  void setSnapDistance(qreal snapDistance);
+  void activateDockWidget(DockWidget *widget);
+  void undo();
+  void redo();
+  void clearHistory();
+  void setUndoLimit(int undoLimit);
+
 private Q_SLOTS:
   void dockWidget_beginMove();
-  void dockWidget_moving(const QPointF &pt);
+  void dockWidget_moving(const QPointF &globalPos);
   void dockWidget_moved();
   void dockWidget_opened();
   void dockWidget_closed();
   void dockWidget_visibleChanged();
   void dockWidget_areaChanged(Dock::Area area);
+  void dockArea_expandedChanged(bool expanded);
+  void preloadNextContent();
+  void updateOcclusion();
+  void dockWidget_isActiveChanged(bool isActive);
+  void dockWidget_uniqueIdChanged();
+  void window_activeFocusItemChanged();
+  void scheduleAutoSave();
+  void autoSaveTimer_timeout();
+  void historyTimer_timeout();
 
 private:
   inline int panelSize(Dock::Area area) const;
   DockArea *createGroup(Dock::Area area, DockArea *item = nullptr);
   QRectF panelRect(Dock::Area area) const;
+  QMap<Dock::Area, QRectF> areaRects(Dock::Area openArea = Dock::NoArea) const;
+  QRectF dropRect(Dock::Area area, int index) const;
+  void dropDockWidget(DockWidget *dw, Dock::Area dropArea);
+  void applyDragPosition(DockWidget *dw);
+  void adoptDockWidget(DockWidget *widget);
+  void releaseDockWidget(DockWidget *widget);
+  void forgetDockWidget(DockWidget *widget);
+  void collapseAutoHideAreas(QQuickItem *except = nullptr);
+  DockGripLayer *gripLayer() const;
+  qint64 contentCost(DockWidget *widget) const;
+  void touchContent(DockWidget *widget);
+  void forgetContent(DockWidget *widget);
+  void queueIncubation(DockWidget *widget);
+  void incubationFinished(DockWidget *widget);
+  void startNextIncubation();
+  void prewarmRecentContent();
+  const QList<DockWidget *> &recentList() const;
+  void registerUniqueId(DockWidget *widget);
+  void setActiveDockWidget(DockWidget *widget);
+
+  void beginBatch();
+  void endBatch();
+  void placeDockWidget(DockWidget *widget, Dock::Area area);
+  void setDockWidgetClosed(DockWidget *widget, bool closed);
+  void applyWidgetLayout(DockWidget *widget, const DockLayoutSnapshot::Widget &layout);
+  void applyAreaOrder(DockArea *area, const DockLayoutSnapshot::Area &layout);
+  void applyDelta(const DockLayoutSnapshot::Delta &delta);
+  void recordLayoutChange(int kind, const QString &key = QString());
+  void scheduleLayoutChange(int kind, const QString &key = QString());
+  void flushHistory();
+  QString layoutPath() const;
+  DockLayoutJournal *journal();
+  QString makeUniqueId(const QString &base) const;
 
 public:
   Qt::Edge topLeftOwner() const;
@@ -87,8 +237,24 @@ public:
   Qt::Edge bottomRightOwner() const;
 
   friend class DockMoveGuide;
+  friend class DockDragSession;
+  friend class DockArea;
+  friend class DockAreaPrivate;
+  friend class DockWidgetPrivate;
   bool enableStateStoring() const;
+  QString layoutFile() const;
+  QString defaultLayout() const;
+  bool autoSave() const;
+  int autoSaveDelay() const;
   Dock::DockWidgetDisplayType defaultDisplayType() const;
+  DockWidget *maximizedDockWidget() const;
+  DockWidget *activeDockWidget() const;
+  bool suspendContentOnMaximize() const;
+  qint64 contentBudget() const;
+  ContentBudgetMode contentBudgetMode() const;
+  int incubationBudget() const;
+  int prewarmCount() const;
+  qreal snapDistance() const;
 
   // QQuickItem interface
 protected:
@@ -2,12 +2,27 @@
 #define DOCKCONTAINER_P_H
 
 #include "dock.h"
+#include "dock_p.h"
+#include "dockcontainer.h"
+#include "dockfloatinglayer.h"
+#include "docklayouthistory.h"
+
+#include <QHash>
+#include <QPointer>
 
 class DockWidget;
 class DockMoveGuide;
 class DockArea;
+class DockGripLayer;
+class DockLayoutJournal;
+class DockLayoutModel;
+class DockQuickOpenModel;
 class DockContainer;
 
+class QQuickItem;
+class QTimer;
+class DockIncubationController;
+
 class DockContainerPrivate {
   DockContainer *q_ptr;
   Q_DECLARE_PUBLIC(DockContainer);
@@ -16,19 +31,79 @@ public:
   DockContainerPrivate(DockContainer *parent);
   QList<DockWidget *> initialWidgets;
   QList<DockWidget *> dockWidgets;
+  QHash<QString, DockWidget *> dockWidgetsById;
+  QHash<DockWidget *, QString> dockWidgetIds;
   QList<DockWidget *> removedDockWidgets;
   QMap<Dock::Area, DockArea *> dockAreas;
 
   DockMoveGuide *dockMoveGuide;
+  DockGripLayer *gripLayer;
 
   Qt::Edge topLeftOwner;
   Qt::Edge topRightOwner;
   Qt::Edge bottomLeftOwner;
   Qt::Edge bottomRightOwner;
   DockWidget *activeDockWidget;
+  QMetaObject::Connection focusConnection;
   Dock::DockWidgetDisplayType defaultDisplayType;
 
   bool enableStateStoring;
+  QString layoutFile;
+  QString defaultLayout;
+
+  // while non zero, area and container relayouts wait for endBatch()
+  int batchDepth;
+  // snapshot entries for docks that were not created yet when it was applied
+  QHash<QString, DockLayoutSnapshot::Widget> pendingLayout;
+
+  QMap<QString, DockLayoutSnapshot> perspectives;
+  QString currentPerspective;
+
+  // undo log; historyBase is the layout the next command starts from
+  DockLayoutHistory history;
+  DockLayoutSnapshot historyBase;
+  QTimer *historyTimer;
+  int pendingHistoryKind;
+  QString pendingHistoryKey;
+  int historyLocked;
+
+  // debounced layout changes, written by the journal off the GUI thread
+  bool autoSave;
+  int autoSaveDelay;
+  QTimer *autoSaveTimer;
+  DockLayoutJournal *journal;
+
+  DockWidget *maximizedWidget;
+  bool layoutDirty;
+  bool suspendContentOnMaximize;
+  QList<QPointer<QQuickItem>> suspendedContents;
+
+  QList<QPointer<DockWidget>> preloadQueue;
+  QTimer *preloadTimer;
+
+  Dock::RecencyList<DockWidget *> contentRecency;
+  qint64 contentBudget;
+  DockContainer::ContentBudgetMode contentBudgetMode;
+  // cost of each loaded content when it was last shown, and their sum
+  QHash<DockWidget *, qint64> contentCosts;
+  qint64 contentUsed;
+
+  QList<QPointer<DockWidget>> incubationQueue;
+  QPointer<DockWidget> incubatingWidget;
+  QPointer<DockIncubationController> incubationController;
+  int incubationBudget;
+
+  QTimer *occlusionTimer;
+
+  Dock::RecencyList<DockWidget *> activationRecency;
+  mutable QList<DockWidget *> recentList;
+  int prewarmCount;
+
+  // z order and snapping of the Float docks
+  DockFloatingLayer floatingLayer;
+
+  DockLayoutModel *layoutModel;
+  DockQuickOpenModel *quickOpenModel;
 };
 
 #endif // DOCKCONTAINER_P_H
@@ -0,0 +1,79 @@
+#include "dockcontentincubator.h"
+#include "dockwidget.h"
+#include "dockwidget_p.h"
+
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QTimer>
+
+DockContentIncubator::DockContentIncubator(DockWidget *widget) : QQmlIncubator(Asynchronous), _widget(widget) {}
+
+void DockContentIncubator::setInitialState(QObject *object) {
+  auto item = qobject_cast<QQuickItem *>(object);
+  if (!item)
+    return;
+
+  item->setParent(_widget);
+  item->setParentItem(_widget);
+  item->setVisible(false);
+}
+
+void DockContentIncubator::statusChanged(Status status) {
+  if (status == Ready || status == Error)
+    _widget->d_func()->incubator_finished();
+}
+
+DockIncubationController::DockIncubationController(QQmlEngine *engine)
+    : QObject(engine), _timer(new QTimer(this)), _budget(5), _previous(nullptr) {
+  _timer->setInterval(16);
+  connect(_timer, &QTimer::timeout, this, &DockIncubationController::timer_timeout);
+}
+
+DockIncubationController *DockIncubationController::install(QQmlEngine *engine) {
+  if (!engine)
+    return nullptr;
+
+  auto current = dynamic_cast<DockIncubationController *>(engine->incubationController());
+  if (current)
+    return current;
+
+  // Replaces the window's controller, so the frame budget is ours to set;
+  // only done when a container asks for a budget
+  auto controller = new DockIncubationController(engine);
+  controller->_previous = engine->incubationController();
+  controller->_previousObject = dynamic_cast<QObject *>(controller->_previous);
+  engine->setIncubationController(controller);
+  return controller;
+}
+
+void DockIncubationController::uninstall(QQmlEngine *engine) {
+  if (!engine)
+    return;
+
+  auto current = dynamic_cast<DockIncubationController *>(engine->incubationController());
+  if (!current)
+    return;
+
+  // the window may be gone by now, then the next window installs its own
+  engine->setIncubationController(current->_previousObject ? current->_previous : nullptr);
+  current->deleteLater();
+}
+
+int DockIncubationController::budget() const {
+  return _budget;
+}
+
+void DockIncubationController::setBudget(int budget) {
+  _budget = qMax(1, budget);
+}
+
+void DockIncubationController::incubatingObjectCountChanged(int count) {
+  if (count && !_timer->isActive())
+    _timer->start();
+  else if (!count)
+    _timer->stop();
+}
+
+void DockIncubationController::timer_timeout() {
+  incubateFor(_budget);
+}
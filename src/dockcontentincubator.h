@@ -0,0 +1,47 @@
+#ifndef DOCKCONTENTINCUBATOR_H
+#define DOCKCONTENTINCUBATOR_H
+
+#include <QObject>
+#include <QPointer>
+#include <QQmlIncubator>
+
+class QQmlEngine;
+class QTimer;
+class DockWidget;
+
+class DockContentIncubator : public QQmlIncubator {
+  DockWidget *_widget;
+
+public:
+  DockContentIncubator(DockWidget *widget);
+
+protected:
+  void setInitialState(QObject *object) override;
+  void statusChanged(Status status) override;
+};
+
+class DockIncubationController : public QObject, public QQmlIncubationController {
+  Q_OBJECT
+  QTimer *_timer;
+  int _budget;
+  // the controller replaced by install(), normally the window's
+  QQmlIncubationController *_previous;
+  QPointer<QObject> _previousObject;
+
+  DockIncubationController(QQmlEngine *engine);
+
+public:
+  static DockIncubationController *install(QQmlEngine *engine);
+  static void uninstall(QQmlEngine *engine);
+
+  int budget() const;
+  void setBudget(int budget);
+
+protected:
+  void incubatingObjectCountChanged(int count) override;
+
+private Q_SLOTS:
+  void timer_timeout();
+};
+
+#endif // DOCKCONTENTINCUBATOR_H
@@ -0,0 +1,159 @@
+#include "dockdragsession.h"
+#include "dockcontainer.h"
+#include "dockcontainer_p.h"
+#include "dockmoveguide.h"
+#include "dockwidget.h"
+
+#include <QQuickWindow>
+
+Q_GLOBAL_STATIC(DockDragSession, globalDragSession)
+
+DockDragSession::DockDragSession(QObject *parent)
+    : QObject(parent), _active{false}, _pending{false}, _pendingSince{0}, _events{0}, _updates{0}, _totalLatency{0},
+      _maxLatency{0} {
+  _clock.start();
+}
+
+DockDragSession *DockDragSession::instance() {
+  return globalDragSession();
+}
+
+bool DockDragSession::isActive() const {
+  return _active;
+}
+
+DockWidget *DockDragSession::dockWidget() const {
+  return _dockWidget;
+}
+
+DockContainer *DockDragSession::source() const {
+  return _source;
+}
+
+DockContainer *DockDragSession::target() const {
+  return _target;
+}
+
+QPointF DockDragSession::globalPos() const {
+  return _globalPos;
+}
+
+void DockDragSession::begin(DockWidget *dockWidget, DockContainer *source) {
+  if (_active)
+    end();
+
+  _dockWidget = dockWidget;
+  _source = source;
+  _window = source ? source->window() : nullptr;
+  _active = true;
+  _events = _updates = 0;
+  _totalLatency = _maxLatency = 0;
+
+  if (_window)
+    _frameConnection = connect(_window, &QQuickWindow::afterAnimating, this, &DockDragSession::window_afterAnimating);
+
+  // the guide of the source shows up right away, the mouse has not left it yet
+  setTarget(source);
+
+  // a move that arrived before the drag was set up is not lost
+  if (_pending)
+    flush();
+}
+
+void DockDragSession::move(const QPointF &globalPos) {
+  _globalPos = globalPos;
+  ++_events;
+
+  if (_pending)
+    return;
+  _pending = true;
+  _pendingSince = _clock.nsecsElapsed();
+
+  if (!_active)
+    return;
+  if (_window)
+    _window->update();
+  else
+    flush();
+}
+
+DockContainer *DockDragSession::end() {
+  if (!_active)
+    return nullptr;
+
+  // the drop goes where the last event was, not where the last frame was
+  if (_pending)
+    flush();
+
+  auto target = _target;
+  if (_target)
+    _target->d_func()->dockMoveGuide->end();
+
+  disconnect(_frameConnection);
+  _active = false;
+  _dockWidget = nullptr;
+  _source = nullptr;
+  _target = nullptr;
+  _window = nullptr;
+  return target;
+}
+
+int DockDragSession::events() const {
+  return _events;
+}
+
+int DockDragSession::updates() const {
+  return _updates;
+}
+
+qreal DockDragSession::averageLatency() const {
+  return _updates ? qreal(_totalLatency) / _updates : 0;
+}
+
+qint64 DockDragSession::maxLatency() const {
+  return _maxLatency;
+}
+
+void DockDragSession::window_afterAnimating() {
+  if (_pending)
+    flush();
+}
+
+void DockDragSession::flush() {
+  auto latency = (_clock.nsecsElapsed() - _pendingSince) / 1000;
+  _pending = false;
+  ++_updates;
+  _totalLatency += latency;
+  _maxLatency = qMax(_maxLatency, latency);
+
+  // the dock itself moves here too, its events only stored the position
+  if (_source && _dockWidget)
+    _source->applyDragPosition(_dockWidget);
+
+  // staying in the current container is the common case and needs no search
+  auto target = _target.data();
+  if (!target || !DockContainer::containsGlobal(target, _globalPos))
+    target = DockContainer::containerAt(_globalPos, _source);
+  setTarget(target);
+
+  if (_target)
+    _target->d_func()->dockMoveGuide->setMousePos(_globalPos);
+
+  Q_EMIT positionChanged(_globalPos);
+}
+
+void DockDragSession::setTarget(DockContainer *target) {
+  if (_target == target)
+    return;
+
+  if (_target)
+    _target->d_func()->dockMoveGuide->end();
+
+  _target = target;
+  if (_target && _dockWidget) {
+    auto guide = _target->d_func()->dockMoveGuide;
+    guide->setAllowedAreas(_dockWidget->allowedAreas());
+    guide->begin(_target->mapToGlobal(QPointF(0, 0)), _target->size());
+  }
+  Q_EMIT targetChanged(_target);
+}
@@ -0,0 +1,67 @@
+#ifndef DOCKDRAGSESSION_H
+#define DOCKDRAGSESSION_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointF>
+#include <QPointer>
+
+class DockContainer;
+class DockWidget;
+class QQuickWindow;
+
+// The one dock drag of the process. Positions are the global ones the mouse
+// events carry; moves only store the newest one, and once per frame the
+// dock is moved to it, the container under it is looked up among all
+// containers and its drop guide is updated. A drag can so end in another container or window than the one
+// it started in.
+class DockDragSession : public QObject {
+  Q_OBJECT
+  QPointer<DockWidget> _dockWidget;
+  QPointer<DockContainer> _source;
+  QPointer<DockContainer> _target;
+  QPointer<QQuickWindow> _window;
+  QMetaObject::Connection _frameConnection;
+  QPointF _globalPos;
+  bool _active;
+  bool _pending;
+
+  // counters of the running or the last drag, latencies in microseconds
+  QElapsedTimer _clock;
+  qint64 _pendingSince;
+  int _events;
+  int _updates;
+  qint64 _totalLatency;
+  qint64 _maxLatency;
+
+public:
+  DockDragSession(QObject *parent = nullptr);
+
+  static DockDragSession *instance();
+
+  bool isActive() const;
+  DockWidget *dockWidget() const;
+  DockContainer *source() const;
+  DockContainer *target() const;
+  QPointF globalPos() const;
+
+  void begin(DockWidget *dockWidget, DockContainer *source);
+  void move(const QPointF &globalPos);
+  DockContainer *end();
+
+  int events() const;
+  int updates() const;
+  qreal averageLatency() const;
+  qint64 maxLatency() const;
+
+Q_SIGNALS:
+  void positionChanged(const QPointF &globalPos);
+  void targetChanged(DockContainer *target);
+
+private:
+  void window_afterAnimating();
+  void flush();
+  void setTarget(DockContainer *target);
+};
+
+#endif // DOCKDRAGSESSION_H
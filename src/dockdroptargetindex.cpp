@@ -0,0 +1,33 @@
+#include "dockdroptargetindex.h"
+
+void DockDropTargetIndex::clear() {
+  _targets.clear();
+  _index.clear();
+}
+
+void DockDropTargetIndex::append(const DockDropTarget &target) {
+  if (target.rect.isEmpty())
+    return;
+  _targets.append(target);
+  _index.append(target.rect);
+}
+
+void DockDropTargetIndex::build(qreal cellSize) {
+  _index.build(cellSize);
+}
+
+int DockDropTargetIndex::hitTest(const QPointF &pos) const {
+  return _index.hitTest(pos);
+}
+
+int DockDropTargetIndex::count() const {
+  return _targets.size();
+}
+
+const DockDropTarget &DockDropTargetIndex::at(int index) const {
+  return _targets.at(index);
+}
+
+const QList<DockDropTarget> &DockDropTargetIndex::targets() const {
+  return _targets;
+}
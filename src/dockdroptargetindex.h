@@ -0,0 +1,45 @@
+#ifndef DOCKDROPTARGETINDEX_H
+#define DOCKDROPTARGETINDEX_H
+
+#include "dock.h"
+#include "dockrectindex.h"
+
+#include <QList>
+#include <QRectF>
+
+class DockArea;
+
+struct DockDropTarget {
+  enum Kind { Button, SplitInsert, TabInsert };
+
+  Kind kind{Button};
+  Dock::Area area{Dock::NoArea};
+  DockArea *dockArea{nullptr};
+  // position the dock is inserted at inside dockArea, -1 appends
+  int index{-1};
+  // global, used for hit testing
+  QRectF rect;
+  // guide coordinates, buttons are painted there
+  QRectF localRect;
+};
+
+// Drop targets of one drag over a uniform grid. Built once when the drag
+// starts, a hit test then only looks at the few targets of one cell. Targets
+// added first win where they overlap, so buttons go in before insertion points.
+class DockDropTargetIndex {
+  QList<DockDropTarget> _targets;
+  DockRectIndex _index;
+
+public:
+  void clear();
+  void append(const DockDropTarget &target);
+  void build(qreal cellSize = 32);
+
+  int hitTest(const QPointF &pos) const;
+
+  int count() const;
+  const DockDropTarget &at(int index) const;
+  const QList<DockDropTarget> &targets() const;
+};
+
+#endif // DOCKDROPTARGETINDEX_H
@@ -0,0 +1,97 @@
+#include "dockfloatinglayer.h"
+#include "dockwidget.h"
+
+#define Z_STEP (1.0 / 64)
+#define SNAP_CELL_SIZE 128
+
+DockFloatingLayer::DockFloatingLayer(qreal base, qreal top)
+    : _base{base}, _top{top}, _step{Z_STEP}, _nextZ{base}, _snapDistance{8} {}
+
+void DockFloatingLayer::raise(DockWidget *widget) {
+  _stack.touch(widget);
+
+  if (_nextZ >= _top) {
+    renumber();
+    return;
+  }
+  widget->setZ(_nextZ);
+  _nextZ += _step;
+}
+
+void DockFloatingLayer::remove(DockWidget *widget) {
+  _stack.remove(widget);
+}
+
+DockWidget *DockFloatingLayer::top() const {
+  return _stack.first();
+}
+
+int DockFloatingLayer::count() const {
+  return _stack.size();
+}
+
+qreal DockFloatingLayer::snapDistance() const {
+  return _snapDistance;
+}
+
+void DockFloatingLayer::setSnapDistance(qreal snapDistance) {
+  _snapDistance = snapDistance;
+}
+
+void DockFloatingLayer::beginSnap(DockWidget *moving, const QList<DockWidget *> &widgets, const QRectF &bounds) {
+  _index.clear();
+  _bounds = bounds;
+  if (_snapDistance <= 0)
+    return;
+
+  for (auto &dw : widgets)
+    if (dw != moving && dw->area() == Dock::Float && dw->isVisible() && dw->parentItem() == moving->parentItem())
+      _index.append(QRectF(dw->position(), dw->size()));
+  _index.build(SNAP_CELL_SIZE);
+}
+
+QPointF DockFloatingLayer::snap(const QRectF &rect) const {
+  if (_snapDistance <= 0)
+    return rect.topLeft();
+
+  // closest edge on each axis, anything farther than the distance is ignored
+  auto dx = _snapDistance + 1;
+  auto dy = _snapDistance + 1;
+  auto consider = [this](qreal from, qreal to, qreal *best) {
+    auto delta = to - from;
+    if (qAbs(delta) <= _snapDistance && qAbs(delta) < qAbs(*best))
+      *best = delta;
+  };
+
+  if (!_bounds.isEmpty()) {
+    consider(rect.left(), _bounds.left(), &dx);
+    consider(rect.right(), _bounds.right(), &dx);
+    consider(rect.top(), _bounds.top(), &dy);
+    consider(rect.bottom(), _bounds.bottom(), &dy);
+  }
+
+  // only floats within the distance are returned, so both axes are near
+  auto reach = rect.adjusted(-_snapDistance, -_snapDistance, _snapDistance, _snapDistance);
+  for (auto i : _index.intersecting(reach)) {
+    auto &other = _index.at(i);
+    consider(rect.left(), other.right(), &dx);
+    consider(rect.right(), other.left(), &dx);
+    consider(rect.left(), other.left(), &dx);
+    consider(rect.right(), other.right(), &dx);
+    consider(rect.top(), other.bottom(), &dy);
+    consider(rect.bottom(), other.top(), &dy);
+    consider(rect.top(), other.top(), &dy);
+    consider(rect.bottom(), other.bottom(), &dy);
+  }
+
+  return rect.topLeft() + QPointF(qAbs(dx) <= _snapDistance ? dx : 0, qAbs(dy) <= _snapDistance ? dy : 0);
+}
+
+void DockFloatingLayer::renumber() {
+  _step = qMin(Z_STEP, (_top - _base) / (2 * qMax(1, _stack.size())));
+  _nextZ = _base;
+  for (auto i = _stack.rbegin(); i != _stack.rend(); ++i) {
+    (*i)->setZ(_nextZ);
+    _nextZ += _step;
+  }
+}
@@ -0,0 +1,46 @@
+#ifndef DOCKFLOATINGLAYER_H
+#define DOCKFLOATINGLAYER_H
+
+#include "dock_p.h"
+#include "dockrectindex.h"
+
+#include <QList>
+#include <QRectF>
+
+class DockWidget;
+
+// Stacking and snapping of the floating docks of one container. The stack
+// hands out increasing z values inside [base, top), raising a dock costs one
+// list splice and one setZ(); when the band runs out the stack is numbered
+// again from the bottom with a step that leaves half of the band free.
+class DockFloatingLayer {
+  Dock::RecencyList<DockWidget *> _stack;
+  qreal _base;
+  qreal _top;
+  qreal _step;
+  qreal _nextZ;
+
+  // other floats of the current drag, built once in beginSnap()
+  DockRectIndex _index;
+  QRectF _bounds;
+  qreal _snapDistance;
+
+public:
+  DockFloatingLayer(qreal base, qreal top);
+
+  void raise(DockWidget *widget);
+  void remove(DockWidget *widget);
+  DockWidget *top() const;
+  int count() const;
+
+  qreal snapDistance() const;
+  void setSnapDistance(qreal snapDistance);
+
+  void beginSnap(DockWidget *moving, const QList<DockWidget *> &widgets, const QRectF &bounds);
+  QPointF snap(const QRectF &rect) const;
+
+private:
+  void renumber();
+};
+
+#endif // DOCKFLOATINGLAYER_H
@@ -0,0 +1,78 @@
+#include "dockgriphandle.h"
+#include "dockgriplayer.h"
+
+#include <QCursor>
+
+DockGripHandle::DockGripHandle(QQuickItem *parent)
+    : QQuickPaintedItem(parent), _edges{}, _owner{nullptr}, _hasHover{false} {
+  setAcceptedMouseButtons(Qt::LeftButton);
+  setAcceptHoverEvents(true);
+}
+
+Qt::Edges DockGripHandle::edges() const {
+  return _edges;
+}
+
+void DockGripHandle::setEdges(Qt::Edges edges) {
+  if (_edges == edges)
+    return;
+
+  _edges = edges;
+
+  // the cursor is fixed per handle, the window picks it up without any hover work
+  if (edges == (Qt::LeftEdge | Qt::TopEdge) || edges == (Qt::RightEdge | Qt::BottomEdge))
+    setCursor(Qt::SizeFDiagCursor);
+  else if (edges == (Qt::RightEdge | Qt::TopEdge) || edges == (Qt::LeftEdge | Qt::BottomEdge))
+    setCursor(Qt::SizeBDiagCursor);
+  else if (edges & (Qt::LeftEdge | Qt::RightEdge))
+    setCursor(Qt::SizeHorCursor);
+  else
+    setCursor(Qt::SizeVerCursor);
+}
+
+QQuickItem *DockGripHandle::owner() const {
+  return _owner;
+}
+
+void DockGripHandle::setOwner(QQuickItem *owner) {
+  _owner = owner;
+}
+
+bool DockGripHandle::contains(const QPointF &point) const {
+  if (!QQuickPaintedItem::contains(point))
+    return false;
+
+  auto layer = qobject_cast<DockGripLayer *>(parentItem());
+  return !layer || !layer->isOccluded(mapToItem(layer, point), _owner);
+}
+
+void DockGripHandle::paint(QPainter *painter) {
+  Q_UNUSED(painter)
+}
+
+void DockGripHandle::mousePressEvent(QMouseEvent *event) {
+  _pressPos = event->windowPos();
+  event->accept();
+  Q_EMIT pressed();
+}
+
+void DockGripHandle::mouseMoveEvent(QMouseEvent *event) {
+  Q_EMIT dragged(event->windowPos() - _pressPos);
+}
+
+void DockGripHandle::mouseReleaseEvent(QMouseEvent *event) {
+  Q_UNUSED(event)
+  Q_EMIT released();
+}
+
+void DockGripHandle::hoverEnterEvent(QHoverEvent *event) {
+  QQuickPaintedItem::hoverEnterEvent(event);
+  _hasHover = true;
+  update();
+}
+
+void DockGripHandle::hoverLeaveEvent(QHoverEvent *event) {
+  QQuickPaintedItem::hoverLeaveEvent(event);
+  _hasHover = false;
+  update();
+}
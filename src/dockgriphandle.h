@@ -0,0 +1,40 @@
+#ifndef DOCKGRIPHANDLE_H
+#define DOCKGRIPHANDLE_H
+
+#include <QQuickPaintedItem>
+
+class DockGripHandle : public QQuickPaintedItem {
+  Q_OBJECT
+  Qt::Edges _edges;
+  QQuickItem *_owner;
+
+protected:
+  bool _hasHover;
+  QPointF _pressPos;
+
+public:
+  DockGripHandle(QQuickItem *parent = nullptr);
+
+  Qt::Edges edges() const;
+  void setEdges(Qt::Edges edges);
+
+  QQuickItem *owner() const;
+  void setOwner(QQuickItem *owner);
+
+  bool contains(const QPointF &point) const override;
+  void paint(QPainter *painter) override;
+
+Q_SIGNALS:
+  void pressed();
+  void dragged(const QPointF &delta);
+  void released();
+
+protected:
+  void mousePressEvent(QMouseEvent *event) override;
+  void mouseMoveEvent(QMouseEvent *event) override;
+  void mouseReleaseEvent(QMouseEvent *event) override;
+  void hoverEnterEvent(QHoverEvent *event) override;
+  void hoverLeaveEvent(QHoverEvent *event) override;
+};
+
+#endif // DOCKGRIPHANDLE_H
@@ -0,0 +1,249 @@
+#include "dockgriplayer.h"
+#include "dockarea.h"
+#include "dockcontainer.h"
+#include "dockgriphandle.h"
+#include "dockgroupresizehandler.h"
+#include "dockwidget.h"
+#include "style/abstractstyle.h"
+
+DockGripLayer::DockGripLayer(DockContainer *parent) : QQuickItem(parent), _container(parent), _sizeBeforeResize{0} {
+  setParentItem(parent);
+}
+
+DockAreaResizeHandler *DockGripLayer::acquireHandler(Qt::Orientation orientation, QQuickItem *owner) {
+  auto h = _freeHandlers.isEmpty() ? new DockAreaResizeHandler(orientation, this) : _freeHandlers.takeLast();
+  h->setOrientation(orientation);
+  h->setOwner(owner);
+  h->setVisible(true);
+  return h;
+}
+
+void DockGripLayer::releaseHandler(DockAreaResizeHandler *handler) {
+  disconnect(handler, &DockAreaResizeHandler::moving, nullptr, nullptr);
+  disconnect(handler, &DockAreaResizeHandler::moved, nullptr, nullptr);
+  handler->setOwner(nullptr);
+  handler->setVisible(false);
+  _freeHandlers.append(handler);
+}
+
+DockGripHandle *DockGripLayer::acquireGrip(Qt::Edges edges, QQuickItem *owner) {
+  auto grip = _freeGrips.isEmpty() ? new DockGripHandle(this) : _freeGrips.takeLast();
+  grip->setEdges(edges);
+  grip->setOwner(owner);
+  grip->setVisible(true);
+  return grip;
+}
+
+void DockGripLayer::releaseGrip(DockGripHandle *grip) {
+  disconnect(grip, &DockGripHandle::pressed, this, nullptr);
+  disconnect(grip, &DockGripHandle::dragged, this, nullptr);
+  grip->setOwner(nullptr);
+  grip->setVisible(false);
+  _freeGrips.append(grip);
+}
+
+void DockGripLayer::trackDockWidget(DockWidget *widget) {
+  connect(widget, &DockWidget::areaChanged, this, &DockGripLayer::dockWidget_geometryChanged);
+  connect(widget, &QQuickItem::xChanged, this, &DockGripLayer::dockWidget_geometryChanged);
+  connect(widget, &QQuickItem::yChanged, this, &DockGripLayer::dockWidget_geometryChanged);
+  connect(widget, &QQuickItem::widthChanged, this, &DockGripLayer::dockWidget_geometryChanged);
+  connect(widget, &QQuickItem::heightChanged, this, &DockGripLayer::dockWidget_geometryChanged);
+  connect(widget, &QQuickItem::zChanged, this, &DockGripLayer::dockWidget_geometryChanged);
+  connect(widget, &QQuickItem::visibleChanged, this, &DockGripLayer::dockWidget_geometryChanged);
+  connect(widget, &QObject::destroyed, this, [this, widget]() { releaseFloatGrips(widget); });
+
+  updateFloatGrips(widget);
+}
+
+void DockGripLayer::untrackDockWidget(DockWidget *widget) {
+  disconnect(widget, nullptr, this, nullptr);
+  releaseFloatGrips(widget);
+}
+
+void DockGripLayer::updateAreaGrip(DockArea *area) {
+  auto grip = _areaGrips.value(area);
+  if (!grip) {
+    switch (area->area()) {
+    case Dock::Left:
+      grip = acquireGrip(Qt::RightEdge, area);
+      break;
+    case Dock::Right:
+      grip = acquireGrip(Qt::LeftEdge, area);
+      break;
+    case Dock::Top:
+      grip = acquireGrip(Qt::BottomEdge, area);
+      break;
+    case Dock::Bottom:
+      grip = acquireGrip(Qt::TopEdge, area);
+      break;
+    default:
+      return;
+    }
+    connect(grip, &DockGripHandle::pressed, this, &DockGripLayer::areaGrip_pressed);
+    connect(grip, &DockGripHandle::dragged, this, &DockGripLayer::areaGrip_dragged);
+    _areaGrips.insert(area, grip);
+  }
+
+  grip->setVisible(area->isOpen() && area->enableResizing() && area->isVisible() &&
+                   (!area->autoHide() || area->expanded()));
+  if (!grip->isVisible())
+    return;
+
+  auto s = dockStyle->resizeHandleSize();
+  QRectF rc(area->position(), area->size());
+  switch (area->area()) {
+  case Dock::Left:
+    rc.setLeft(rc.right() - s);
+    break;
+  case Dock::Right:
+    rc.setWidth(s);
+    break;
+  case Dock::Top:
+    rc.setTop(rc.bottom() - s);
+    break;
+  case Dock::Bottom:
+    rc.setHeight(s);
+    break;
+  default:
+    break;
+  }
+  grip->setPosition(rc.topLeft());
+  grip->setSize(rc.size());
+}
+
+void DockGripLayer::addOccluder(QQuickItem *item) {
+  if (!_occluders.contains(item))
+    _occluders.append(item);
+}
+
+void DockGripLayer::removeOccluder(QQuickItem *item) {
+  _occluders.removeOne(item);
+}
+
+bool DockGripLayer::isOccluded(const QPointF &point, QQuickItem *owner) const {
+  auto ownerZ = owner ? owner->z() : 0.;
+  for (auto &o : _occluders) {
+    if (o == owner || !o->isVisible() || o->z() <= ownerZ)
+      continue;
+    if (QRectF(o->position(), o->size()).contains(point))
+      return true;
+  }
+  return false;
+}
+
+void DockGripLayer::areaGrip_pressed() {
+  auto grip = qobject_cast<DockGripHandle *>(sender());
+  auto area = grip ? qobject_cast<DockArea *>(grip->owner()) : nullptr;
+  if (area)
+    _sizeBeforeResize = area->panelSize();
+}
+
+void DockGripLayer::areaGrip_dragged(const QPointF &delta) {
+  auto grip = qobject_cast<DockGripHandle *>(sender());
+  auto area = grip ? qobject_cast<DockArea *>(grip->owner()) : nullptr;
+  if (!area)
+    return;
+
+  switch (area->area()) {
+  case Dock::Left:
+    area->setPanelSize(_sizeBeforeResize + delta.x());
+    break;
+  case Dock::Right:
+    area->setPanelSize(_sizeBeforeResize - delta.x());
+    break;
+  case Dock::Top:
+    area->setPanelSize(_sizeBeforeResize + delta.y());
+    break;
+  case Dock::Bottom:
+    area->setPanelSize(_sizeBeforeResize - delta.y());
+    break;
+  default:
+    break;
+  }
+}
+
+void DockGripLayer::floatGrip_pressed() {
+  auto grip = qobject_cast<DockGripHandle *>(sender());
+  auto widget = grip ? qobject_cast<DockWidget *>(grip->owner()) : nullptr;
+  if (widget)
+    _rectBeforeResize = QRectF(widget->position(), widget->size());
+}
+
+void DockGripLayer::floatGrip_dragged(const QPointF &delta) {
+  auto grip = qobject_cast<DockGripHandle *>(sender());
+  auto widget = grip ? qobject_cast<DockWidget *>(grip->owner()) : nullptr;
+  if (!widget)
+    return;
+
+  auto rc = _rectBeforeResize;
+  if (grip->edges() & Qt::LeftEdge)
+    rc.setLeft(_rectBeforeResize.left() + delta.x());
+  if (grip->edges() & Qt::TopEdge)
+    rc.setTop(_rectBeforeResize.top() + delta.y());
+  if (grip->edges() & Qt::RightEdge)
+    rc.setRight(_rectBeforeResize.right() + delta.x());
+  if (grip->edges() & Qt::BottomEdge)
+    rc.setBottom(_rectBeforeResize.bottom() + delta.y());
+
+  widget->setPosition(rc.topLeft());
+  widget->setSize(rc.size());
+}
+
+void DockGripLayer::dockWidget_geometryChanged() {
+  auto widget = qobject_cast<DockWidget *>(sender());
+  if (widget)
+    updateFloatGrips(widget);
+}
+
+void DockGripLayer::updateFloatGrips(DockWidget *widget) {
+  auto floating = widget->area() == Dock::Float && widget->resizable() && widget->isVisible() &&
+                  widget->parentItem() == _container && !widget->isMaximized();
+  if (!floating) {
+    releaseFloatGrips(widget);
+    return;
+  }
+
+  auto &grips = _floatGrips[widget];
+  if (grips.isEmpty()) {
+    const Qt::Edges edges[] = {Qt::LeftEdge,
+                               Qt::RightEdge,
+                               Qt::TopEdge,
+                               Qt::BottomEdge,
+                               Qt::LeftEdge | Qt::TopEdge,
+                               Qt::RightEdge | Qt::TopEdge,
+                               Qt::LeftEdge | Qt::BottomEdge,
+                               Qt::RightEdge | Qt::BottomEdge};
+    for (auto &e : edges) {
+      auto grip = acquireGrip(e, widget);
+      connect(grip, &DockGripHandle::pressed, this, &DockGripLayer::floatGrip_pressed);
+      connect(grip, &DockGripHandle::dragged, this, &DockGripLayer::floatGrip_dragged);
+      grips.append(grip);
+    }
+    addOccluder(widget);
+  }
+
+  auto b = dockStyle->widgetResizePadding();
+  QRectF rc(widget->position(), widget->size());
+  for (auto &grip : grips) {
+    auto e = grip->edges();
+    QRectF r;
+    r.setLeft(e & Qt::LeftEdge ? rc.left() : (e & Qt::RightEdge ? rc.right() - b : rc.left() + b));
+    r.setTop(e & Qt::TopEdge ? rc.top() : (e & Qt::BottomEdge ? rc.bottom() - b : rc.top() + b));
+    r.setWidth(e & (Qt::LeftEdge | Qt::RightEdge) ? b : rc.width() - 2 * b);
+    r.setHeight(e & (Qt::TopEdge | Qt::BottomEdge) ? b : rc.height() - 2 * b);
+    grip->setPosition(r.topLeft());
+    grip->setSize(r.size());
+    grip->setZ(widget->z());
+  }
+}
+
+void DockGripLayer::releaseFloatGrips(DockWidget *widget) {
+  auto i = _floatGrips.find(widget);
+  if (i == _floatGrips.end())
+    return;
+
+  for (auto &grip : *i)
+    releaseGrip(grip);
+  _floatGrips.erase(i);
+  removeOccluder(widget);
+}
@@ -0,0 +1,53 @@
+#ifndef DOCKGRIPLAYER_H
+#define DOCKGRIPLAYER_H
+
+#include <QHash>
+#include <QQuickItem>
+
+class DockArea;
+class DockContainer;
+class DockGripHandle;
+class DockWidget;
+class DockAreaResizeHandler;
+
+class DockGripLayer : public QQuickItem {
+  Q_OBJECT
+  DockContainer *_container;
+  QHash<DockArea *, DockGripHandle *> _areaGrips;
+  QHash<DockWidget *, QList<DockGripHandle *>> _floatGrips;
+  QList<DockGripHandle *> _freeGrips;
+  QList<DockAreaResizeHandler *> _freeHandlers;
+  QList<QQuickItem *> _occluders;
+
+  QRectF _rectBeforeResize;
+  qreal _sizeBeforeResize;
+
+public:
+  DockGripLayer(DockContainer *parent);
+
+  DockAreaResizeHandler *acquireHandler(Qt::Orientation orientation, QQuickItem *owner);
+  void releaseHandler(DockAreaResizeHandler *handler);
+
+  void trackDockWidget(DockWidget *widget);
+  void untrackDockWidget(DockWidget *widget);
+  void updateAreaGrip(DockArea *area);
+
+  void addOccluder(QQuickItem *item);
+  void removeOccluder(QQuickItem *item);
+  bool isOccluded(const QPointF &point, QQuickItem *owner) const;
+
+private Q_SLOTS:
+  void areaGrip_pressed();
+  void areaGrip_dragged(const QPointF &delta);
+  void floatGrip_pressed();
+  void floatGrip_dragged(const QPointF &delta);
+  void dockWidget_geometryChanged();
+
+private:
+  DockGripHandle *acquireGrip(Qt::Edges edges, QQuickItem *owner);
+  void releaseGrip(DockGripHandle *grip);
+  void updateFloatGrips(DockWidget *widget);
+  void releaseFloatGrips(DockWidget *widget);
+};
+
+#endif // DOCKGRIPLAYER_H
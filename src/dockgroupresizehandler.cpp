@@ -10,7 +10,12 @@ Qt::Orientation DockAreaResizeHandler::orientation() const {
 }
 
 DockAreaResizeHandler::DockAreaResizeHandler(Qt::Orientation orientation, QQuickItem *parent)
-    : QQuickPaintedItem(parent), _orientation(orientation), _hasHover{false} {
+    : DockGripHandle(parent), _orientation(Qt::Horizontal), _index{0}, _pos{0} {
+  setOrientation(orientation);
+}
+
+void DockAreaResizeHandler::setOrientation(Qt::Orientation orientation) {
+  _orientation = orientation;
   switch (orientation) {
   case Qt::Horizontal:
     setCursor(Qt::SplitVCursor);
@@ -22,9 +27,6 @@ DockAreaResizeHandler::DockAreaResizeHandler(Qt::Orientation orientation, QQuick
     setWidth(dockStyle->resizeHandleSize());
     break;
   }
-
-  setAcceptedMouseButtons(Qt::LeftButton);
-  setAcceptHoverEvents(true);
 }
 
 int DockAreaResizeHandler::index() const {
@@ -36,7 +38,7 @@ void DockAreaResizeHandler::setIndex(int index) {
 }
 
 qreal DockAreaResizeHandler::pos() const {
-  if (_orientation)
+  if (_orientation == Qt::Horizontal)
     return y();
 
   return x();
@@ -51,7 +53,6 @@ void DockAreaResizeHandler::paint(QPainter *painter) {
 }
 
 void DockAreaResizeHandler::mousePressEvent(QMouseEvent *event) {
-  QQuickPaintedItem::mousePressEvent(event);
   event->accept();
 
   if (_orientation == Qt::Horizontal) {
@@ -65,8 +66,6 @@ void DockAreaResizeHandler::mousePressEvent(QMouseEvent *event) {
 }
 
 void DockAreaResizeHandler::mouseMoveEvent(QMouseEvent *event) {
-  QQuickPaintedItem::mouseMoveEvent(event);
-
   bool ok{};
   if (_orientation == Qt::Horizontal) {
     auto newY = _lastHandlerPos + (event->windowPos().y() - _lastMousePos);
@@ -88,21 +87,9 @@ void DockAreaResizeHandler::mouseMoveEvent(QMouseEvent *event) {
 }
 
 void DockAreaResizeHandler::mouseReleaseEvent(QMouseEvent *event) {
+  Q_UNUSED(event)
   Q_EMIT moved();
   ungrabMouse();
-  QQuickPaintedItem::mouseReleaseEvent(event);
-}
-
-void DockAreaResizeHandler::hoverEnterEvent(QHoverEvent *event) {
-  QQuickPaintedItem::hoverEnterEvent(event);
-  _hasHover = true;
-  update();
-}
-
-void DockAreaResizeHandler::hoverLeaveEvent(QHoverEvent *event) {
-  QQuickPaintedItem::hoverLeaveEvent(event);
-  _hasHover = false;
-  update();
 }
 
 void DockAreaResizeHandler::drawCircle(QPainter *painter, const QPointF &center, bool hover) {
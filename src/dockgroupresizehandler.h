@@ -1,12 +1,11 @@
 #ifndef DOCKGROUPRESIZEHANDLER_H
 #define DOCKGROUPRESIZEHANDLER_H
 
-#include <QQuickPaintedItem>
+#include "dockgriphandle.h"
 
-class DockAreaResizeHandler : public QQuickPaintedItem {
+class DockAreaResizeHandler : public DockGripHandle {
   Q_OBJECT
   Qt::Orientation _orientation;
-  bool _hasHover;
   qreal _lastMousePos;
   qreal _lastHandlerPos;
   int _index;
@@ -21,7 +20,7 @@ Q_SIGNALS:
 
   // QQuickPaintedItem interface
 public:
-  void paint(QPainter *painter);
+  void paint(QPainter *painter) override;
 
   // QQuickItem interface
   int index() const;
@@ -31,16 +30,12 @@ public:
   void setPos(const qreal &pos);
 
   Qt::Orientation orientation() const;
+  void setOrientation(Qt::Orientation orientation);
 
 protected:
-  void mousePressEvent(QMouseEvent *event);
-  void mouseMoveEvent(QMouseEvent *event);
-  void mouseReleaseEvent(QMouseEvent *event);
-
-  // QQuickItem interface
-protected:
-  void hoverEnterEvent(QHoverEvent *event);
-  void hoverLeaveEvent(QHoverEvent *event);
+  void mousePressEvent(QMouseEvent *event) override;
+  void mouseMoveEvent(QMouseEvent *event) override;
+  void mouseReleaseEvent(QMouseEvent *event) override;
 
 private:
   void drawCircle(QPainter *painter, const QPointF &center, bool hover = false);
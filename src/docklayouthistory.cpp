@@ -0,0 +1,111 @@
+#include "docklayouthistory.h"
+
+DockLayoutHistory::DockLayoutHistory(int capacity) : _first{0}, _count{0}, _index{0} {
+  _commands.resize(qMax(1, capacity));
+  _clock.start();
+}
+
+int DockLayoutHistory::capacity() const {
+  return _commands.size();
+}
+
+void DockLayoutHistory::setCapacity(int capacity) {
+  capacity = qMax(1, capacity);
+  if (capacity == _commands.size())
+    return;
+
+  // keep the newest commands that still fit
+  QList<Command> commands;
+  commands.reserve(capacity);
+  auto skip = qMax(0, _count - capacity);
+  for (int i = skip; i < _count; ++i)
+    commands.append(at(i));
+
+  _index = qMax(0, _index - skip);
+  _count = commands.size();
+  _first = 0;
+  commands.resize(capacity);
+  _commands = commands;
+}
+
+bool DockLayoutHistory::canUndo() const {
+  return _index > 0;
+}
+
+bool DockLayoutHistory::canRedo() const {
+  return _index < _count;
+}
+
+void DockLayoutHistory::push(Kind kind, const QString &key, const DockLayoutSnapshot::Delta &redo,
+                             const DockLayoutSnapshot::Delta &undo) {
+  auto now = _clock.elapsed();
+
+  // an undone tail is gone once something new happens
+  _count = _index;
+
+  if (_count && coalesces(kind)) {
+    auto &last = at(_count - 1);
+    if (last.kind == kind && last.key == key && now - last.time < CoalesceInterval) {
+      merge(&last.redo, redo);
+      // the undo side has to go back to the state before the first step
+      auto older = last.undo;
+      last.undo = undo;
+      merge(&last.undo, older);
+      last.time = now;
+      return;
+    }
+  }
+
+  if (_count == _commands.size()) {
+    _first = (_first + 1) % _commands.size();
+    --_count;
+  }
+
+  auto &command = at(_count);
+  command.kind = kind;
+  command.key = key;
+  command.time = now;
+  command.redo = redo;
+  command.undo = undo;
+
+  _index = ++_count;
+}
+
+const DockLayoutHistory::Command *DockLayoutHistory::undo() {
+  if (!canUndo())
+    return nullptr;
+  return &at(--_index);
+}
+
+const DockLayoutHistory::Command *DockLayoutHistory::redo() {
+  if (!canRedo())
+    return nullptr;
+  return &at(_index++);
+}
+
+void DockLayoutHistory::clear() {
+  for (auto &c : _commands)
+    c = Command();
+  _first = _count = _index = 0;
+}
+
+DockLayoutHistory::Command &DockLayoutHistory::at(int index) {
+  return _commands[(_first + index) % _commands.size()];
+}
+
+bool DockLayoutHistory::coalesces(Kind kind) {
+  return kind == SplitRatio || kind == PanelResize || kind == Move;
+}
+
+void DockLayoutHistory::merge(DockLayoutSnapshot::Delta *into, const DockLayoutSnapshot::Delta &newer) {
+  DockLayoutSnapshot base;
+  base.areas = into->areas;
+  base.widgets = into->widgets;
+  base.apply(newer);
+
+  into->areas = base.areas;
+  into->widgets = base.widgets;
+  for (auto &id : newer.removedWidgets)
+    if (!into->removedWidgets.contains(id))
+      into->removedWidgets.append(id);
+}
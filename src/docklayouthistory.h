@@ -0,0 +1,51 @@
+#ifndef DOCKLAYOUTHISTORY_H
+#define DOCKLAYOUTHISTORY_H
+
+#include "docklayoutsnapshot.h"
+
+#include <QElapsedTimer>
+
+// Bounded undo/redo log of layout operations. Each command only keeps the
+// snapshot entries the operation changed, both ways, so its size does not
+// depend on what the docks show. The oldest command is dropped when full.
+class DockLayoutHistory {
+public:
+  enum Kind { Move, SplitRatio, PanelResize, Close, Open, Detach, Layout };
+
+  struct Command {
+    Kind kind{Layout};
+    QString key;
+    qint64 time{0};
+    DockLayoutSnapshot::Delta redo;
+    DockLayoutSnapshot::Delta undo;
+  };
+
+  // consecutive commands of the same gesture closer than this become one
+  static constexpr qint64 CoalesceInterval = 1000;
+
+  DockLayoutHistory(int capacity = 100);
+
+  int capacity() const;
+  void setCapacity(int capacity);
+
+  bool canUndo() const;
+  bool canRedo() const;
+
+  void push(Kind kind, const QString &key, const DockLayoutSnapshot::Delta &redo, const DockLayoutSnapshot::Delta &undo);
+  const Command *undo();
+  const Command *redo();
+  void clear();
+
+private:
+  Command &at(int index);
+  static bool coalesces(Kind kind);
+  static void merge(DockLayoutSnapshot::Delta *into, const DockLayoutSnapshot::Delta &newer);
+
+  QList<Command> _commands;
+  int _first;
+  int _count;
+  int _index;
+  QElapsedTimer _clock;
+};
+
+#endif // DOCKLAYOUTHISTORY_H
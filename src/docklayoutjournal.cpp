@@ -0,0 +1,215 @@
+#include "docklayoutjournal.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#define JOURNAL_VERSION 1
+
+namespace {
+
+void writeHeader(QIODevice *device, quint64 generation) {
+  QDataStream stream(device);
+  stream.setVersion(QDataStream::Qt_6_0);
+  stream << DockLayoutJournal::Magic << quint16(JOURNAL_VERSION) << generation;
+}
+
+void makeParentPath(const QString &path) {
+  QDir().mkpath(QFileInfo(path).absolutePath());
+}
+
+} // namespace
+
+DockLayoutJournal::DockLayoutJournal(const QString &snapshotPath)
+    : _snapshotPath{snapshotPath}, _records{0}, _compactThreshold{64}, _synced{false}, _failed{false} {
+  // one thread keeps the records in submission order
+  _pool.setMaxThreadCount(1);
+}
+
+DockLayoutJournal::~DockLayoutJournal() {
+  _pool.waitForDone();
+}
+
+QString DockLayoutJournal::snapshotPath() const {
+  return _snapshotPath;
+}
+
+QString DockLayoutJournal::journalPath() const {
+  return _snapshotPath + QStringLiteral(".journal");
+}
+
+int DockLayoutJournal::compactThreshold() const {
+  return _compactThreshold;
+}
+
+void DockLayoutJournal::setCompactThreshold(int compactThreshold) {
+  _compactThreshold = qMax(1, compactThreshold);
+}
+
+bool DockLayoutJournal::recover(DockLayoutSnapshot *snapshot) {
+  _pool.waitForDone();
+
+  DockLayoutSnapshot s;
+  auto found = DockLayoutSnapshot::fromFile(_snapshotPath, &s);
+  _records = 0;
+
+  QFile file(journalPath());
+  auto stale = true;
+  qint64 good = 0;
+
+  if (file.open(QIODevice::ReadOnly)) {
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic;
+    quint16 version;
+    quint64 generation;
+    stream >> magic >> version >> generation;
+
+    // a journal written against an older snapshot is already folded into it
+    stale = stream.status() != QDataStream::Ok || magic != Magic || version > JOURNAL_VERSION
+            || generation != s.generation;
+
+    good = file.pos();
+    while (!stale && !file.atEnd()) {
+      quint32 length;
+      quint16 checksum;
+      stream >> length >> checksum;
+      if (stream.status() != QDataStream::Ok || length > file.size() - file.pos())
+        break;
+
+      auto payload = file.read(length);
+      if (payload.size() != static_cast<qsizetype>(length) || qChecksum(payload) != checksum)
+        break;
+
+      QDataStream in(payload);
+      in.setVersion(QDataStream::Qt_6_0);
+      DockLayoutSnapshot::Delta delta;
+      in >> delta;
+      if (in.status() != QDataStream::Ok)
+        break;
+
+      s.apply(delta);
+      good = file.pos();
+      ++_records;
+      found = true;
+    }
+
+    if (!stale && good < file.size()) {
+      qWarning() << "Dropping" << file.size() - good << "bytes of incomplete dock layout journal";
+      file.close();
+      if (file.open(QIODevice::ReadWrite))
+        file.resize(good);
+    }
+  }
+
+  _last = s;
+  _synced = true;
+
+  if (stale) {
+    auto path = journalPath();
+    auto generation = s.generation;
+    _pool.start([this, path, generation]() {
+      makeParentPath(path);
+      QSaveFile out(path);
+      auto ok = out.open(QIODevice::WriteOnly);
+      if (ok) {
+        writeHeader(&out, generation);
+        ok = out.commit();
+      }
+      _failed = !ok;
+    });
+  }
+
+  if (found)
+    *snapshot = s;
+  return found;
+}
+
+void DockLayoutJournal::append(const DockLayoutSnapshot &snapshot) {
+  // without a recovered base the deltas would have nothing to apply to
+  // a failed reset left the journal on the previous base, start over
+  if (!_synced || _failed || _records >= _compactThreshold) {
+    compact(snapshot);
+    return;
+  }
+
+  auto delta = DockLayoutSnapshot::diff(_last, snapshot);
+  if (delta.isEmpty())
+    return;
+
+  auto generation = _last.generation;
+  _last = snapshot;
+  _last.generation = generation;
+  ++_records;
+
+  auto path = journalPath();
+  _pool.start([this, path, generation, delta]() {
+    if (_failed)
+      return;
+
+    QByteArray payload;
+    QDataStream in(&payload, QIODevice::WriteOnly);
+    in.setVersion(QDataStream::Qt_6_0);
+    in << delta;
+
+    makeParentPath(path);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+      qWarning() << "Unable to append to dock layout journal" << path << file.errorString();
+      _failed = true;
+      return;
+    }
+    if (!file.size())
+      writeHeader(&file, generation);
+
+    // a lost record would make every later delta apply to the wrong base;
+    // the next append compacts instead
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << quint32(payload.size()) << qChecksum(payload);
+    auto written = out.writeRawData(payload.constData(), payload.size());
+    if (out.status() != QDataStream::Ok || written != payload.size() || !file.flush()) {
+      qWarning() << "Unable to append to dock layout journal" << path << file.errorString();
+      _failed = true;
+    }
+  });
+}
+
+void DockLayoutJournal::compact(const DockLayoutSnapshot &snapshot) {
+  auto generation = _last.generation + 1;
+  _last = snapshot;
+  _last.generation = generation;
+  _records = 0;
+  _synced = true;
+
+  auto snapshotPath = _snapshotPath;
+  auto path = journalPath();
+  auto s = _last;
+  _pool.start([this, snapshotPath, path, s]() {
+    // the snapshot goes first; a crash before the journal is reset leaves an
+    // older generation journal behind, which recovery ignores
+    makeParentPath(snapshotPath);
+    if (!s.toFile(snapshotPath)) {
+      _failed = true;
+      return;
+    }
+
+    QSaveFile out(path);
+    auto ok = out.open(QIODevice::WriteOnly);
+    if (ok) {
+      writeHeader(&out, s.generation);
+      ok = out.commit();
+    }
+    if (!ok)
+      qWarning() << "Unable to reset dock layout journal" << path << out.errorString();
+    _failed = !ok;
+  });
+}
+
+void DockLayoutJournal::waitForDone() {
+  _pool.waitForDone();
+}
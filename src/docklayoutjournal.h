@@ -0,0 +1,43 @@
+#ifndef DOCKLAYOUTJOURNAL_H
+#define DOCKLAYOUTJOURNAL_H
+
+#include "docklayoutsnapshot.h"
+
+#include <QThreadPool>
+
+#include <atomic>
+
+// Append-only log of layout changes next to a snapshot file. Writes run in
+// order on one worker thread; every record carries its length and checksum
+// so a torn tail left by a crash is detected and dropped on recovery.
+class DockLayoutJournal {
+public:
+  static constexpr quint32 Magic = 0x4b444c4a; // "KDLJ"
+
+  DockLayoutJournal(const QString &snapshotPath);
+  ~DockLayoutJournal();
+
+  QString snapshotPath() const;
+  QString journalPath() const;
+
+  int compactThreshold() const;
+  void setCompactThreshold(int compactThreshold);
+
+  bool recover(DockLayoutSnapshot *snapshot);
+  void append(const DockLayoutSnapshot &snapshot);
+  void compact(const DockLayoutSnapshot &snapshot);
+  void waitForDone();
+
+private:
+  QString _snapshotPath;
+  QThreadPool _pool;
+  DockLayoutSnapshot _last;
+  int _records;
+  int _compactThreshold;
+  bool _synced;
+  // set by the worker when the journal could not be reset to a new base;
+  // deltas are dropped until a compaction succeeds
+  std::atomic<bool> _failed;
+};
+
+#endif // DOCKLAYOUTJOURNAL_H
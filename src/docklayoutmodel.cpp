@@ -0,0 +1,325 @@
+#include "docklayoutmodel.h"
+#include "dockarea.h"
+#include "dockcontainer.h"
+#include "dockwidget.h"
+
+#include <QMetaEnum>
+
+DockLayoutModel::DockLayoutModel(QObject *parent) : QAbstractItemModel(parent), _container(nullptr) {}
+
+DockContainer *DockLayoutModel::container() const {
+  return _container;
+}
+
+QModelIndex DockLayoutModel::index(int row, int column, const QModelIndex &parent) const {
+  if (column != 0 || row < 0)
+    return QModelIndex();
+
+  if (!parent.isValid())
+    return row < _groups.size() ? createIndex(row, 0, quintptr(0)) : QModelIndex();
+
+  if (parent.internalId() || parent.row() >= _groups.size())
+    return QModelIndex();
+
+  // Children carry their group row + 1 as internal id
+  if (row >= _groups.at(parent.row()).widgets.size())
+    return QModelIndex();
+  return createIndex(row, 0, quintptr(parent.row() + 1));
+}
+
+QModelIndex DockLayoutModel::parent(const QModelIndex &child) const {
+  if (!child.isValid() || !child.internalId())
+    return QModelIndex();
+  return createIndex(int(child.internalId() - 1), 0, quintptr(0));
+}
+
+int DockLayoutModel::rowCount(const QModelIndex &parent) const {
+  if (!parent.isValid())
+    return _groups.size();
+  if (parent.internalId() || parent.row() >= _groups.size())
+    return 0;
+  return _groups.at(parent.row()).widgets.size();
+}
+
+int DockLayoutModel::columnCount(const QModelIndex &parent) const {
+  Q_UNUSED(parent)
+  return 1;
+}
+
+QVariant DockLayoutModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid())
+    return QVariant();
+
+  if (index.internalId()) {
+    auto dw = dockWidget(index);
+    if (!dw)
+      return QVariant();
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case TitleRole:
+      return dw->title();
+    case AreaRole:
+      return QVariant::fromValue(dw->area());
+    case VisibilityRole:
+      return QVariant::fromValue(dw->visibility());
+    case ActiveRole:
+      return dw->isActive();
+    case DockWidgetRole:
+      return QVariant::fromValue(dw);
+    case DockAreaRole:
+      return QVariant::fromValue(dw->dockArea());
+    }
+    return QVariant();
+  }
+
+  if (index.row() >= _groups.size())
+    return QVariant();
+  const auto &g = _groups.at(index.row());
+
+  switch (role) {
+  case Qt::DisplayRole:
+  case TitleRole:
+    return g.area ? QString(QMetaEnum::fromType<Dock::Area>().valueToKey(g.area->area())) : QStringLiteral("Other");
+  case AreaRole:
+    return QVariant::fromValue(g.area ? g.area->area() : Dock::NoArea);
+  case VisibilityRole:
+    return g.area ? g.area->isOpen() : !g.widgets.isEmpty();
+  case ActiveRole:
+    for (auto &dw : g.widgets)
+      if (dw->isActive())
+        return true;
+    return false;
+  case DockAreaRole:
+    return QVariant::fromValue(g.area);
+  }
+  return QVariant();
+}
+
+QHash<int, QByteArray> DockLayoutModel::roleNames() const {
+  return {{TitleRole, "title"},   {AreaRole, "area"},           {VisibilityRole, "visibility"},
+          {ActiveRole, "active"}, {DockWidgetRole, "dockWidget"}, {DockAreaRole, "dockArea"}};
+}
+
+QModelIndex DockLayoutModel::widgetIndex(DockWidget *widget) const {
+  auto i = _widgetGroups.find(widget);
+  if (i == _widgetGroups.end())
+    return QModelIndex();
+  return createIndex(_groups.at(*i).widgets.indexOf(widget), 0, quintptr(*i + 1));
+}
+
+QModelIndex DockLayoutModel::areaIndex(DockArea *area) const {
+  for (int i = 0; i < _groups.size(); ++i)
+    if (_groups.at(i).area == area)
+      return createIndex(i, 0, quintptr(0));
+  return QModelIndex();
+}
+
+DockWidget *DockLayoutModel::dockWidget(const QModelIndex &index) const {
+  if (!index.isValid() || !index.internalId())
+    return nullptr;
+
+  auto group = int(index.internalId() - 1);
+  if (group >= _groups.size() || index.row() >= _groups.at(group).widgets.size())
+    return nullptr;
+  return _groups.at(group).widgets.at(index.row());
+}
+
+void DockLayoutModel::setContainer(DockContainer *container) {
+  if (_container == container)
+    return;
+
+  if (_container)
+    _container->disconnect(this);
+
+  _container = container;
+
+  if (_container) {
+    connect(_container, &DockContainer::dockWidgetAdded, this, &DockLayoutModel::container_dockWidgetAdded);
+    connect(_container, &DockContainer::dockWidgetRemoved, this, &DockLayoutModel::container_dockWidgetRemoved);
+  }
+  reset();
+  Q_EMIT containerChanged(_container);
+}
+
+void DockLayoutModel::reset() {
+  beginResetModel();
+
+  for (auto &g : _groups) {
+    if (g.area)
+      g.area->disconnect(this);
+    for (auto &dw : g.widgets)
+      dw->disconnect(this);
+  }
+  _groups.clear();
+  _widgetGroups.clear();
+
+  if (_container) {
+    for (auto &da : _container->dockAreas()) {
+      _groups.append({da, da->dockWidgets()});
+      connect(da, &DockArea::dockWidgetAdded, this, &DockLayoutModel::dockArea_dockWidgetAdded);
+      connect(da, &DockArea::dockWidgetRemoved, this, &DockLayoutModel::dockArea_dockWidgetRemoved);
+      connect(da, &DockArea::dockWidgetMoved, this, &DockLayoutModel::dockArea_dockWidgetMoved);
+      connect(da, &DockArea::isOpenChanged, this, &DockLayoutModel::dockArea_dataChanged);
+    }
+    _groups.append({nullptr, {}});
+
+    for (int i = 0; i < _groups.size() - 1; ++i)
+      for (auto &dw : _groups.at(i).widgets) {
+        _widgetGroups.insert(dw, i);
+        watchWidget(dw);
+      }
+
+    for (auto &dw : _container->dockWidgets())
+      if (!_widgetGroups.contains(dw)) {
+        _groups.last().widgets.append(dw);
+        _widgetGroups.insert(dw, freeGroup());
+        watchWidget(dw);
+      }
+  }
+
+  endResetModel();
+}
+
+int DockLayoutModel::freeGroup() const {
+  return _groups.size() - 1;
+}
+
+void DockLayoutModel::insertWidget(int group, int row, DockWidget *widget) {
+  if (group < 0 || group >= _groups.size())
+    return;
+
+  auto &widgets = _groups[group].widgets;
+  row = qBound(0, row, widgets.size());
+
+  beginInsertRows(createIndex(group, 0, quintptr(0)), row, row);
+  widgets.insert(row, widget);
+  _widgetGroups.insert(widget, group);
+  endInsertRows();
+
+  auto groupIndex = createIndex(group, 0, quintptr(0));
+  Q_EMIT dataChanged(groupIndex, groupIndex, {VisibilityRole, ActiveRole});
+}
+
+void DockLayoutModel::removeWidget(DockWidget *widget) {
+  auto i = _widgetGroups.find(widget);
+  if (i == _widgetGroups.end())
+    return;
+
+  auto group = *i;
+  auto row = _groups.at(group).widgets.indexOf(widget);
+
+  beginRemoveRows(createIndex(group, 0, quintptr(0)), row, row);
+  _groups[group].widgets.removeAt(row);
+  _widgetGroups.erase(i);
+  endRemoveRows();
+
+  auto groupIndex = createIndex(group, 0, quintptr(0));
+  Q_EMIT dataChanged(groupIndex, groupIndex, {VisibilityRole, ActiveRole});
+}
+
+void DockLayoutModel::watchWidget(DockWidget *widget) {
+  connect(widget, &DockWidget::titleChanged, this, &DockLayoutModel::dockWidget_dataChanged, Qt::UniqueConnection);
+  connect(widget, &DockWidget::areaChanged, this, &DockLayoutModel::dockWidget_dataChanged, Qt::UniqueConnection);
+  connect(widget, &DockWidget::visibilityChanged, this, &DockLayoutModel::dockWidget_dataChanged, Qt::UniqueConnection);
+  connect(widget, &DockWidget::isActiveChanged, this, &DockLayoutModel::dockWidget_dataChanged, Qt::UniqueConnection);
+}
+
+void DockLayoutModel::container_dockWidgetAdded(DockWidget *widget) {
+  watchWidget(widget);
+  if (!_widgetGroups.contains(widget))
+    insertWidget(freeGroup(), _groups.isEmpty() ? 0 : _groups.last().widgets.size(), widget);
+}
+
+void DockLayoutModel::container_dockWidgetRemoved(DockWidget *widget) {
+  removeWidget(widget);
+  widget->disconnect(this);
+}
+
+void DockLayoutModel::dockArea_dockWidgetAdded(DockWidget *widget, int index) {
+  auto area = qobject_cast<DockArea *>(sender());
+  auto target = areaIndex(area);
+  if (!target.isValid())
+    return;
+
+  auto i = _widgetGroups.constFind(widget);
+  if (i != _widgetGroups.constEnd()) {
+    // Coming from the area-less row: a move keeps the delegate alive
+    auto group = *i;
+    auto row = _groups.at(group).widgets.indexOf(widget);
+    index = qBound(0, index, _groups.at(target.row()).widgets.size());
+    if (group == target.row())
+      return;
+
+    beginMoveRows(createIndex(group, 0, quintptr(0)), row, row, target, index);
+    _groups[group].widgets.removeAt(row);
+    _groups[target.row()].widgets.insert(index, widget);
+    _widgetGroups.insert(widget, target.row());
+    endMoveRows();
+    return;
+  }
+
+  watchWidget(widget);
+  insertWidget(target.row(), index, widget);
+}
+
+void DockLayoutModel::dockArea_dockWidgetRemoved(DockWidget *widget, int index) {
+  Q_UNUSED(index)
+  auto i = _widgetGroups.constFind(widget);
+  if (i == _widgetGroups.constEnd())
+    return;
+
+  auto group = *i;
+  auto row = _groups.at(group).widgets.indexOf(widget);
+
+  if (!_container || widget->dockContainer() != _container) {
+    removeWidget(widget);
+    return;
+  }
+
+  // Still owned by the container, so it moves to the area-less row
+  auto free = freeGroup();
+  auto freeRow = _groups.at(free).widgets.size();
+  beginMoveRows(createIndex(group, 0, quintptr(0)), row, row, createIndex(free, 0, quintptr(0)), freeRow);
+  _groups[group].widgets.removeAt(row);
+  _groups[free].widgets.append(widget);
+  _widgetGroups.insert(widget, free);
+  endMoveRows();
+}
+
+void DockLayoutModel::dockArea_dockWidgetMoved(DockWidget *widget, int from, int to) {
+  Q_UNUSED(from)
+  auto i = _widgetGroups.constFind(widget);
+  if (i == _widgetGroups.constEnd())
+    return;
+
+  auto group = *i;
+  auto &widgets = _groups[group].widgets;
+  auto row = widgets.indexOf(widget);
+  to = qBound(0, to, widgets.size() - 1);
+  if (row == to)
+    return;
+
+  auto parent = createIndex(group, 0, quintptr(0));
+  beginMoveRows(parent, row, row, parent, to > row ? to + 1 : to);
+  widgets.move(row, to);
+  endMoveRows();
+}
+
+void DockLayoutModel::dockArea_dataChanged() {
+  auto index = areaIndex(qobject_cast<DockArea *>(sender()));
+  if (index.isValid())
+    Q_EMIT dataChanged(index, index, {VisibilityRole});
+}
+
+void DockLayoutModel::dockWidget_dataChanged() {
+  auto dw = qobject_cast<DockWidget *>(sender());
+  auto index = widgetIndex(dw);
+  if (!index.isValid())
+    return;
+
+  Q_EMIT dataChanged(index, index, {Qt::DisplayRole, TitleRole, AreaRole, VisibilityRole, ActiveRole, DockAreaRole});
+
+  auto parentIndex = index.parent();
+  Q_EMIT dataChanged(parentIndex, parentIndex, {ActiveRole});
+}
@@ -0,0 +1,68 @@
+#ifndef DOCKLAYOUTMODEL_H
+#define DOCKLAYOUTMODEL_H
+
+#include <QAbstractItemModel>
+#include <QHash>
+
+class DockArea;
+class DockContainer;
+class DockWidget;
+
+// Container (root) -> areas -> dock widgets. Docks that are not in an area
+// (floating, detached or closed) are listed under a last, area-less row.
+class DockLayoutModel : public QAbstractItemModel {
+  Q_OBJECT
+  Q_PROPERTY(DockContainer *container READ container WRITE setContainer NOTIFY containerChanged)
+
+  struct Group {
+    DockArea *area;
+    QList<DockWidget *> widgets;
+  };
+
+  DockContainer *_container;
+  QList<Group> _groups;
+  QHash<DockWidget *, int> _widgetGroups;
+
+public:
+  enum Roles { TitleRole = Qt::UserRole + 1, AreaRole, VisibilityRole, ActiveRole, DockWidgetRole, DockAreaRole };
+  Q_ENUM(Roles)
+
+  DockLayoutModel(QObject *parent = nullptr);
+
+  DockContainer *container() const;
+
+  QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+  QModelIndex parent(const QModelIndex &child) const override;
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+  Q_INVOKABLE QModelIndex widgetIndex(DockWidget *widget) const;
+  Q_INVOKABLE QModelIndex areaIndex(DockArea *area) const;
+  Q_INVOKABLE DockWidget *dockWidget(const QModelIndex &index) const;
+
+public Q_SLOTS:
+  void setContainer(DockContainer *container);
+  void reset();
+
+Q_SIGNALS:
+  void containerChanged(DockContainer *container);
+
+private Q_SLOTS:
+  void container_dockWidgetAdded(DockWidget *widget);
+  void container_dockWidgetRemoved(DockWidget *widget);
+  void dockArea_dockWidgetAdded(DockWidget *widget, int index);
+  void dockArea_dockWidgetRemoved(DockWidget *widget, int index);
+  void dockArea_dockWidgetMoved(DockWidget *widget, int from, int to);
+  void dockArea_dataChanged();
+  void dockWidget_dataChanged();
+
+private:
+  int freeGroup() const;
+  void insertWidget(int group, int row, DockWidget *widget);
+  void removeWidget(DockWidget *widget);
+  void watchWidget(DockWidget *widget);
+};
+
+#endif // DOCKLAYOUTMODEL_H
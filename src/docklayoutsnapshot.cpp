@@ -0,0 +1,203 @@
+#include "docklayoutsnapshot.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QSaveFile>
+
+#include <algorithm>
+
+// Files above this size are read through a memory mapping
+#define MAP_THRESHOLD (64 * 1024)
+
+using LayoutRegistry = QHash<QString, DockLayoutSnapshot::Factory>;
+Q_GLOBAL_STATIC(LayoutRegistry, layoutRegistry)
+
+bool DockLayoutSnapshot::isEmpty() const {
+  return areas.isEmpty() && widgets.isEmpty();
+}
+
+bool DockLayoutSnapshot::Delta::isEmpty() const {
+  return areas.isEmpty() && widgets.isEmpty() && removedWidgets.isEmpty();
+}
+
+const DockLayoutSnapshot::Area *DockLayoutSnapshot::findArea(qint32 area) const {
+  for (auto &a : areas)
+    if (a.area == area)
+      return &a;
+  return nullptr;
+}
+
+const DockLayoutSnapshot::Widget *DockLayoutSnapshot::findWidget(const QString &id) const {
+  for (auto &w : widgets)
+    if (w.id == id)
+      return &w;
+  return nullptr;
+}
+
+QByteArray DockLayoutSnapshot::toByteArray() const {
+  QByteArray data;
+  QDataStream stream(&data, QIODevice::WriteOnly);
+  stream.setVersion(QDataStream::Qt_6_0);
+  stream << Magic << Version << generation << *this;
+  return data;
+}
+
+bool DockLayoutSnapshot::fromByteArray(const QByteArray &data, DockLayoutSnapshot *snapshot) {
+  QDataStream stream(data);
+  stream.setVersion(QDataStream::Qt_6_0);
+
+  quint32 magic;
+  quint16 version;
+  stream >> magic >> version;
+  if (magic != Magic || version > Version) {
+    qWarning() << "Unsupported dock layout data, version" << version;
+    return false;
+  }
+
+  DockLayoutSnapshot s;
+  if (version >= 2)
+    stream >> s.generation;
+  stream >> s;
+  if (stream.status() != QDataStream::Ok) {
+    qWarning() << "Corrupted dock layout data";
+    return false;
+  }
+
+  *snapshot = s;
+  return true;
+}
+
+bool DockLayoutSnapshot::fromFile(const QString &path, DockLayoutSnapshot *snapshot) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  if (file.size() > MAP_THRESHOLD) {
+    auto mem = file.map(0, file.size());
+    if (mem) {
+      auto ok = fromByteArray(QByteArray::fromRawData(reinterpret_cast<const char *>(mem), file.size()), snapshot);
+      file.unmap(mem);
+      return ok;
+    }
+  }
+  return fromByteArray(file.readAll(), snapshot);
+}
+
+bool DockLayoutSnapshot::toFile(const QString &path) const {
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning() << "Unable to write dock layout to" << path << file.errorString();
+    return false;
+  }
+  file.write(toByteArray());
+  return file.commit();
+}
+
+DockLayoutSnapshot::Delta DockLayoutSnapshot::diff(const DockLayoutSnapshot &from, const DockLayoutSnapshot &to) {
+  Delta delta;
+
+  for (auto &a : to.areas) {
+    auto old = from.findArea(a.area);
+    if (!old || !(*old == a))
+      delta.areas.append(a);
+  }
+
+  QHash<QString, const Widget *> previous;
+  previous.reserve(from.widgets.size());
+  for (auto &w : from.widgets)
+    previous.insert(w.id, &w);
+
+  for (auto &w : to.widgets) {
+    auto old = previous.take(w.id);
+    if (!old || !(*old == w))
+      delta.widgets.append(w);
+  }
+
+  for (auto i = previous.cbegin(); i != previous.cend(); ++i)
+    delta.removedWidgets.append(i.key());
+
+  return delta;
+}
+
+void DockLayoutSnapshot::apply(const Delta &delta) {
+  for (auto &a : delta.areas) {
+    auto i = std::find_if(areas.begin(), areas.end(), [&a](const Area &other) { return other.area == a.area; });
+    if (i == areas.end())
+      areas.append(a);
+    else
+      *i = a;
+  }
+
+  QHash<QString, qsizetype> indexes;
+  indexes.reserve(widgets.size());
+  for (qsizetype i = 0; i < widgets.size(); ++i)
+    indexes.insert(widgets.at(i).id, i);
+
+  for (auto &w : delta.widgets) {
+    auto i = indexes.constFind(w.id);
+    if (i == indexes.constEnd()) {
+      indexes.insert(w.id, widgets.size());
+      widgets.append(w);
+    } else {
+      widgets[*i] = w;
+    }
+  }
+
+  if (!delta.removedWidgets.isEmpty())
+    widgets.removeIf([&delta](const Widget &w) { return delta.removedWidgets.contains(w.id); });
+}
+
+void DockLayoutSnapshot::registerLayout(const QString &name, Factory factory) {
+  layoutRegistry->insert(name, factory);
+}
+
+const DockLayoutSnapshot *DockLayoutSnapshot::registeredLayout(const QString &name) {
+  auto factory = layoutRegistry->value(name);
+  return factory ? &factory() : nullptr;
+}
+
+bool operator==(const DockLayoutSnapshot::Area &a, const DockLayoutSnapshot::Area &b) {
+  return a.area == b.area && qFuzzyCompare(a.panelSize, b.panelSize) && a.autoHide == b.autoHide
+         && a.displayType == b.displayType && a.currentIndex == b.currentIndex && a.widgets == b.widgets
+         && a.itemSizes == b.itemSizes;
+}
+
+bool operator==(const DockLayoutSnapshot::Widget &a, const DockLayoutSnapshot::Widget &b) {
+  return a.id == b.id && a.area == b.area && a.geometry == b.geometry && a.closed == b.closed;
+}
+
+QDataStream &operator<<(QDataStream &stream, const DockLayoutSnapshot::Area &area) {
+  return stream << area.area << area.panelSize << area.autoHide << area.displayType << area.currentIndex << area.widgets
+                << area.itemSizes;
+}
+
+QDataStream &operator>>(QDataStream &stream, DockLayoutSnapshot::Area &area) {
+  return stream >> area.area >> area.panelSize >> area.autoHide >> area.displayType >> area.currentIndex >> area.widgets
+         >> area.itemSizes;
+}
+
+QDataStream &operator<<(QDataStream &stream, const DockLayoutSnapshot::Widget &widget) {
+  return stream << widget.id << widget.area << widget.geometry << widget.closed;
+}
+
+QDataStream &operator>>(QDataStream &stream, DockLayoutSnapshot::Widget &widget) {
+  return stream >> widget.id >> widget.area >> widget.geometry >> widget.closed;
+}
+
+QDataStream &operator<<(QDataStream &stream, const DockLayoutSnapshot &snapshot) {
+  return stream << snapshot.areas << snapshot.widgets;
+}
+
+QDataStream &operator>>(QDataStream &stream, DockLayoutSnapshot &snapshot) {
+  return stream >> snapshot.areas >> snapshot.widgets;
+}
+
+QDataStream &operator<<(QDataStream &stream, const DockLayoutSnapshot::Delta &delta) {
+  return stream << delta.areas << delta.widgets << delta.removedWidgets;
+}
+
+QDataStream &operator>>(QDataStream &stream, DockLayoutSnapshot::Delta &delta) {
+  return stream >> delta.areas >> delta.widgets >> delta.removedWidgets;
+}
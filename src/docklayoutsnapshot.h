@@ -0,0 +1,79 @@
+#ifndef DOCKLAYOUTSNAPSHOT_H
+#define DOCKLAYOUTSNAPSHOT_H
+
+#include <QByteArray>
+#include <QList>
+#include <QRectF>
+#include <QString>
+#include <QStringList>
+
+class QDataStream;
+
+// Plain layout description, QtCore only so tools can read and write it too
+struct DockLayoutSnapshot {
+  static constexpr quint32 Magic = 0x4b444c53; // "KDLS"
+  static constexpr quint16 Version = 2;
+
+  struct Area {
+    qint32 area{0};
+    // negative leaves the panel at the size it has
+    qreal panelSize{-1};
+    bool autoHide{false};
+    qint32 displayType{0};
+    qint32 currentIndex{-1};
+    QStringList widgets;
+    QList<qreal> itemSizes;
+  };
+
+  struct Widget {
+    QString id;
+    qint32 area{0};
+    QRectF geometry;
+    bool closed{false};
+  };
+
+  // bumped on every full rewrite, a journal only applies on top of its own generation
+  quint64 generation{0};
+  QList<Area> areas;
+  QList<Widget> widgets;
+
+  // entries that differ between two snapshots
+  struct Delta {
+    QList<Area> areas;
+    QList<Widget> widgets;
+    QStringList removedWidgets;
+
+    bool isEmpty() const;
+  };
+
+  bool isEmpty() const;
+  const Area *findArea(qint32 area) const;
+  const Widget *findWidget(const QString &id) const;
+
+  QByteArray toByteArray() const;
+  static bool fromByteArray(const QByteArray &data, DockLayoutSnapshot *snapshot);
+  static bool fromFile(const QString &path, DockLayoutSnapshot *snapshot);
+  bool toFile(const QString &path) const;
+
+  static Delta diff(const DockLayoutSnapshot &from, const DockLayoutSnapshot &to);
+  void apply(const Delta &delta);
+
+  // layouts compiled into the binary by the layout compiler, see tools/docklayoutc
+  using Factory = const DockLayoutSnapshot &(*)();
+  static void registerLayout(const QString &name, Factory factory);
+  static const DockLayoutSnapshot *registeredLayout(const QString &name);
+};
+
+bool operator==(const DockLayoutSnapshot::Area &a, const DockLayoutSnapshot::Area &b);
+bool operator==(const DockLayoutSnapshot::Widget &a, const DockLayoutSnapshot::Widget &b);
+
+QDataStream &operator<<(QDataStream &stream, const DockLayoutSnapshot::Area &area);
+QDataStream &operator>>(QDataStream &stream, DockLayoutSnapshot::Area &area);
+QDataStream &operator<<(QDataStream &stream, const DockLayoutSnapshot::Widget &widget);
+QDataStream &operator>>(QDataStream &stream, DockLayoutSnapshot::Widget &widget);
+QDataStream &operator<<(QDataStream &stream, const DockLayoutSnapshot &snapshot);
+QDataStream &operator>>(QDataStream &stream, DockLayoutSnapshot &snapshot);
+QDataStream &operator<<(QDataStream &stream, const DockLayoutSnapshot::Delta &delta);
+QDataStream &operator>>(QDataStream &stream, DockLayoutSnapshot::Delta &delta);
+
+#endif // DOCKLAYOUTSNAPSHOT_H
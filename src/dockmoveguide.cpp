@@ -5,14 +5,88 @@
 #include <QQuickWindow>
 #include <QScreen>
 #include "style/abstractstyle.h"
+#include "dockarea.h"
+#include "dockarea_p.h"
 #include "dockcontainer.h"
+#include "docktabbar.h"
+#include "dockwidget.h"
 #include "movedropguide.h"
 
-void DockMoveGuide::insertToAreas(Dock::Area a, const QRectF &rc) {
-  _areas.insert(a, qMakePair<QRectF, QRectF>(std::move(const_cast<QRectF &>(rc)), {mapToGlobal(rc.topLeft()), rc.size()}));
+// half the thickness of the hot zone around a split boundary
+#define INSERT_MARGIN 12
+
+void DockMoveGuide::addButton(Dock::Area area, const QRectF &rc) {
+  DockDropTarget target;
+  target.kind = DockDropTarget::Button;
+  target.area = area;
+  target.localRect = rc;
+  target.rect = QRectF(mapToGlobal(rc.topLeft()), rc.size());
+  _targets.append(target);
+}
+
+void DockMoveGuide::addInsertionPoints(DockArea *dockArea) {
+  auto d = dockArea->d_func();
+  if (!(_allowedAreas & d->area) || !dockArea->isOpen() || d->dockWidgets.isEmpty() || d->isCollapsed())
+    return;
+
+  DockDropTarget target;
+  target.area = d->area;
+  target.dockArea = dockArea;
+
+  if (d->effectiveDisplayType() == Dock::TabbedView) {
+    if (!d->tabBar || !d->tabBar->isVisible())
+      return;
+
+    // each half of a tab inserts on its side of it
+    target.kind = DockDropTarget::TabInsert;
+    for (int i = 0; i < d->tabBar->count(); ++i) {
+      auto tab = d->tabBar->tabButton(i);
+      auto half = QRectF(0, 0, tab->width() / 2, tab->height());
+      target.index = i;
+      target.rect = globalRect(tab, half);
+      _targets.append(target);
+
+      target.index = i + 1;
+      target.rect = globalRect(tab, half.translated(half.width(), 0));
+      _targets.append(target);
+    }
+    return;
+  }
+
+  if (d->effectiveDisplayType() != Dock::SplitView || !(d->isVertical() || d->isHorizontal()))
+    return;
+
+  // boundaries before the first widget, between neighbours and after the last
+  target.kind = DockDropTarget::SplitInsert;
+  auto areaRect = globalRect(dockArea, QRectF(0, 0, dockArea->width(), dockArea->height()));
+  auto count = d->dockWidgets.count();
+  for (int i = 0; i <= count; ++i) {
+    auto prev = i ? globalRect(d->dockWidgets.at(i - 1), QRectF(0, 0, d->dockWidgets.at(i - 1)->width(),
+                                                                   d->dockWidgets.at(i - 1)->height()))
+                  : QRectF();
+    auto next = i < count ? globalRect(d->dockWidgets.at(i), QRectF(0, 0, d->dockWidgets.at(i)->width(),
+                                                                      d->dockWidgets.at(i)->height()))
+                          : QRectF();
+    target.index = i;
+
+    if (d->isVertical()) {
+      auto y = !i ? next.top() : i == count ? prev.bottom() : (prev.bottom() + next.top()) / 2;
+      target.rect = QRectF(areaRect.left(), y - INSERT_MARGIN, areaRect.width(), INSERT_MARGIN * 2).intersected(areaRect);
+    } else {
+      auto x = !i ? next.left() : i == count ? prev.right() : (prev.right() + next.left()) / 2;
+      target.rect = QRectF(x - INSERT_MARGIN, areaRect.top(), INSERT_MARGIN * 2, areaRect.height()).intersected(areaRect);
+    }
+    _targets.append(target);
+  }
+}
+
+QRectF DockMoveGuide::globalRect(QQuickItem *item, const QRectF &rc) const {
+  // both corners, so rotated tab bars still give the right rectangle
+  return QRectF(item->mapToGlobal(rc.topLeft()), item->mapToGlobal(rc.bottomRight())).normalized();
 }
 
-DockMoveGuide::DockMoveGuide(DockContainer *parent) : QQuickPaintedItem(parent), _parentDockContainer(parent) {
+DockMoveGuide::DockMoveGuide(DockContainer *parent)
+    : QQuickPaintedItem(parent), _parentDockContainer(parent), _current{-1} {
   _window = new QQuickWindow;
   setParentItem(_window->contentItem());
   _window->hide();
@@ -36,13 +110,17 @@ void DockMoveGuide::begin(const QPointF &pos, const QSizeF &size) {
 
   setVisible(true);
   setSize(size);
+  _targets.clear();
+  _previews.clear();
+  _current = -1;
+  _area = Dock::Detached;
   QRegion region;
   QRect rc(0, 0, dockStyle->dropButtonSize() + 10, dockStyle->dropButtonSize() + 10);
 
   if (_allowedAreas & Dock::Center) {
     rc.moveCenter(QPoint(size.width() / 2, size.height() / 2));
     region = region.united(rc);
-    insertToAreas(Dock::Center, rc);
+    addButton(Dock::Center, rc);
   }
 
   rc.setSize(QSize(dockStyle->dropButtonSize(), dockStyle->dropButtonSize()));
@@ -50,21 +128,21 @@ void DockMoveGuide::begin(const QPointF &pos, const QSizeF &size) {
   if (_allowedAreas & Dock::Left) {
     rc.moveLeft(size.width() / 2 - dockStyle->dropButtonSize() - dockStyle->dropButtonSpace());
     region = region.united(rc);
-    insertToAreas(Dock::Left, rc);
+    addButton(Dock::Left, rc);
 
     rc.moveLeft(50);
     region = region.united(rc);
-    insertToAreas(Dock::Left, rc);
+    addButton(Dock::Left, rc);
   }
 
   if (_allowedAreas & Dock::Right) {
     rc.moveRight(size.width() / 2 + dockStyle->dropButtonSize() + dockStyle->dropButtonSpace());
     region = region.united(rc);
-    insertToAreas(Dock::Right, rc);
+    addButton(Dock::Right, rc);
 
     rc.moveRight(size.width() - 50);
     region = region.united(rc);
-    insertToAreas(Dock::Right, rc);
+    addButton(Dock::Right, rc);
   }
 
   // back to center
@@ -73,24 +151,28 @@ void DockMoveGuide::begin(const QPointF &pos, const QSizeF &size) {
   if (_allowedAreas & Dock::Top) {
     rc.moveTop(size.height() / 2 - dockStyle->dropButtonSize() - dockStyle->dropButtonSpace());
     region = region.united(rc);
-    insertToAreas(Dock::Top, rc);
+    addButton(Dock::Top, rc);
 
     rc.moveTop(50);
     region = region.united(rc);
-    insertToAreas(Dock::Top, rc);
+    addButton(Dock::Top, rc);
   }
 
   if (_allowedAreas & Dock::Bottom) {
     rc.moveBottom(size.height() / 2 + dockStyle->dropButtonSize() + dockStyle->dropButtonSpace());
     region = region.united(rc);
-    insertToAreas(Dock::Bottom, rc);
+    addButton(Dock::Bottom, rc);
 
     rc.moveBottom(size.height() - 50);
     region = region.united(rc);
-    insertToAreas(Dock::Bottom, rc);
+    addButton(Dock::Bottom, rc);
   }
 
   _window->setMask(region);
+
+  for (auto &da : _parentDockContainer->dockAreas())
+    addInsertionPoints(da);
+  _targets.build();
 }
 
 void DockMoveGuide::end() {
@@ -102,6 +184,14 @@ Dock::Area DockMoveGuide::area() const {
   return _area;
 }
 
+DockArea *DockMoveGuide::dockArea() const {
+  return _current >= 0 ? _targets.at(_current).dockArea : nullptr;
+}
+
+int DockMoveGuide::insertIndex() const {
+  return _current >= 0 ? _targets.at(_current).index : -1;
+}
+
 Dock::Areas DockMoveGuide::allowedAreas() const {
   return _allowedAreas;
 }
@@ -117,28 +207,34 @@ QPointF DockMoveGuide::mousePos() const {
 void DockMoveGuide::setMousePos(const QPointF &mousePos) {
   _mousePos = mousePos;
 
-  _area = Dock::Detached;
-  auto mouse = QCursor::pos();
-  for (auto i = _areas.begin(); i != _areas.end(); ++i) {
-    auto contains = i.value().second.contains(mouse);
-    if (contains) {
-      _area = i.key();
-      auto rc = _parentDockContainer->panelRect(_area);
-      _dropArea->setPosition(rc.topLeft());
-      _dropArea->setSize(rc.size());
-      _dropArea->setVisible(true);
-    }
-  }
-  if (_area == Dock::Detached || _area == Dock::Float)
+  auto current = _targets.hitTest(mousePos);
+  if (current == _current)
+    return;
+
+  _current = current;
+  _area = _current >= 0 ? _targets.at(_current).area : Dock::Detached;
+
+  if (_area == Dock::Detached || _area == Dock::Float) {
     _dropArea->setVisible(false);
+    update();
+    return;
+  }
+
+  auto preview = _previews.find(_current);
+  if (preview == _previews.end())
+    preview = _previews.insert(_current, _parentDockContainer->dropRect(_area, insertIndex()));
+
+  _dropArea->setPosition(preview->topLeft());
+  _dropArea->setSize(preview->size());
+  _dropArea->setVisible(!preview->isEmpty());
 
   update();
 }
 
 void DockMoveGuide::paint(QPainter *painter) {
-  auto mousePos = QCursor::pos();
-  for (auto i = _areas.begin(); i != _areas.end(); ++i) {
-    auto contains = i.value().second.contains(mousePos);
-    dockStyle->paintDropButton(painter, i.key(), i.value().first, contains);
+  for (int i = 0; i < _targets.count(); ++i) {
+    auto &t = _targets.at(i);
+    if (t.kind == DockDropTarget::Button)
+      dockStyle->paintDropButton(painter, t.area, t.localRect, i == _current);
   }
 }
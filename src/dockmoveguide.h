@@ -1,13 +1,15 @@
 #ifndef DOCKMOVEGUIDE_H
 #define DOCKMOVEGUIDE_H
 
+#include <QHash>
 #include <QQuickPaintedItem>
-#include <QPair>
 #include "dock.h"
+#include "dockdroptargetindex.h"
 
 class QQuickWindow;
 class DockContainer;
 class MoveDropGuide;
+class DockArea;
 
 class DockMoveGuide : public QQuickPaintedItem {
   Q_OBJECT
@@ -16,13 +18,16 @@ class DockMoveGuide : public QQuickPaintedItem {
   Dock::Area _area;
   Dock::Areas _allowedAreas;
   QQuickWindow *_window;
-  using LocalAndGlobalRect = QPair<QRectF, QRectF>;
 
-  QMultiMap<Dock::Area, LocalAndGlobalRect> _areas;
-  //    QMultiMap<Dock::Area, QRectF> _globalAreas;
+  DockDropTargetIndex _targets;
+  int _current;
+  // where the widget would land, per target, from a dry run of the layout
+  QHash<int, QRectF> _previews;
   MoveDropGuide *_dropArea;
 
-  void insertToAreas(Dock::Area, const QRectF &);
+  void addButton(Dock::Area area, const QRectF &rc);
+  void addInsertionPoints(DockArea *dockArea);
+  QRectF globalRect(QQuickItem *item, const QRectF &rc) const;
 
 public:
   DockMoveGuide(DockContainer *parent = nullptr);
@@ -35,6 +40,8 @@ public:
   void setMousePos(const QPointF &mousePos);
 
   Dock::Area area() const;
+  DockArea *dockArea() const;
+  int insertIndex() const;
 
   Dock::Areas allowedAreas() const;
   void setAllowedAreas(const Dock::Areas &allowedAreas);
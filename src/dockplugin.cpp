@@ -3,6 +3,8 @@
 #include "dockcontainer.h"
 #include "dockwidget.h"
 #include "dockarea.h"
+#include "docklayoutmodel.h"
+#include "dockquickopenmodel.h"
 #include "docktabbar.h"
 #include "dockdockableitem.h"
 #include "dockwidgetmovehandler.h"
@@ -20,6 +22,8 @@ void DockPlugin::registerDockPlugin() {
   qmlRegisterType<DockTabBar>("Kaj.Dock", 1, 0, "DockTabBar");
   qmlRegisterType<DockDockableItem>("Kaj.Dock", 1, 0, "DockableItem");
   qmlRegisterType<DockWidgetMoveHandler>("Kaj.Dock", 1, 0, "DockWidgetMoveHandler");
+  qmlRegisterType<DockLayoutModel>("Kaj.Dock", 1, 0, "DockLayoutModel");
+  qmlRegisterType<DockQuickOpenModel>("Kaj.Dock", 1, 0, "DockQuickOpenModel");
   qmlRegisterUncreatableMetaObject(Dock::staticMetaObject, "Kaj.Dock", 1, 0, "Dock", "Error: only enums");
 
   qRegisterMetaType<QList<DockWidget *>>();
@@ -0,0 +1,316 @@
+#include "dockquickopenmodel.h"
+#include "dockcontainer.h"
+#include "dockwidget.h"
+
+#include <algorithm>
+
+// prefix matches rank above substring matches, which rank above fuzzy ones
+#define SCORE_BAND 1000
+
+DockQuickOpenModel::DockQuickOpenModel(QObject *parent)
+    : QAbstractListModel(parent), _container(nullptr), _maximumResults(50), _searchPending(false) {}
+
+DockContainer *DockQuickOpenModel::container() const {
+  return _container;
+}
+
+QString DockQuickOpenModel::query() const {
+  return _query;
+}
+
+int DockQuickOpenModel::maximumResults() const {
+  return _maximumResults;
+}
+
+int DockQuickOpenModel::count() const {
+  return _results.size();
+}
+
+int DockQuickOpenModel::rowCount(const QModelIndex &parent) const {
+  return parent.isValid() ? 0 : _results.size();
+}
+
+QVariant DockQuickOpenModel::data(const QModelIndex &index, int role) const {
+  auto dw = dockWidget(index.row());
+  if (!index.isValid() || !dw)
+    return QVariant();
+
+  switch (role) {
+  case Qt::DisplayRole:
+  case TitleRole:
+    return dw->title();
+  case UniqueIdRole:
+    return dw->uniqueId();
+  case DockWidgetRole:
+    return QVariant::fromValue(dw);
+  case ScoreRole:
+    return _results.at(index.row()).score;
+  }
+  return QVariant();
+}
+
+QHash<int, QByteArray> DockQuickOpenModel::roleNames() const {
+  return {{TitleRole, "title"}, {UniqueIdRole, "uniqueId"}, {DockWidgetRole, "dockWidget"}, {ScoreRole, "score"}};
+}
+
+DockWidget *DockQuickOpenModel::dockWidget(int row) const {
+  if (row < 0 || row >= _results.size())
+    return nullptr;
+  return _results.at(row).widget;
+}
+
+void DockQuickOpenModel::activate(int row) {
+  auto dw = dockWidget(row);
+  if (!dw || !_container)
+    return;
+
+  if (!dw->dockArea() && dw->visibility() == DockWidget::Closed)
+    dw->open();
+  _container->activateDockWidget(dw);
+}
+
+quint64 DockQuickOpenModel::charMask(const QString &folded) {
+  quint64 mask{0};
+  for (auto &c : folded) {
+    auto u = c.unicode();
+    if (u >= 'a' && u <= 'z')
+      mask |= quint64(1) << (u - 'a');
+    else if (u >= '0' && u <= '9')
+      mask |= quint64(1) << (26 + u - '0');
+    else if (c.isLetterOrNumber())
+      mask |= quint64(1) << (36 + u % 28);
+  }
+  return mask;
+}
+
+int DockQuickOpenModel::score(const QString &query, const QString &folded) {
+  if (query.isEmpty())
+    return 0;
+
+  if (folded.startsWith(query))
+    return 2 * SCORE_BAND + qBound(1, SCORE_BAND - int(folded.size() - query.size()), SCORE_BAND);
+
+  auto isWordStart = [&folded](int i) { return i == 0 || !folded.at(i - 1).isLetterOrNumber(); };
+
+  auto pos = folded.indexOf(query);
+  if (pos > 0)
+    return SCORE_BAND + qBound(1, int((isWordStart(pos) ? 800 : 600) - pos), SCORE_BAND - 1);
+
+  // Fuzzy: every query character in order, rewarding runs and word starts
+  int s{0};
+  int last{-1};
+  for (auto &c : query) {
+    auto i = folded.indexOf(c, last + 1);
+    if (i == -1)
+      return -1;
+
+    s += 10;
+    if (i == last + 1)
+      s += 15;
+    if (isWordStart(i))
+      s += 20;
+    s -= i - last - 1;
+    last = i;
+  }
+  return qBound(1, s, SCORE_BAND - 1);
+}
+
+void DockQuickOpenModel::setContainer(DockContainer *container) {
+  if (_container == container)
+    return;
+
+  if (_container)
+    _container->disconnect(this);
+  for (auto &e : _entries)
+    e.widget->disconnect(this);
+  _entries.clear();
+  _entryIndexes.clear();
+
+  _container = container;
+
+  if (_container) {
+    connect(_container, &DockContainer::dockWidgetAdded, this, &DockQuickOpenModel::container_dockWidgetAdded);
+    connect(_container, &DockContainer::dockWidgetRemoved, this, &DockQuickOpenModel::container_dockWidgetRemoved);
+    connect(_container, &DockContainer::recentDockWidgetsChanged, this, [this]() {
+      if (_query.isEmpty())
+        scheduleSearch();
+    });
+    for (auto &dw : _container->dockWidgets())
+      addEntry(dw);
+  }
+
+  search();
+  Q_EMIT containerChanged(_container);
+}
+
+void DockQuickOpenModel::setQuery(const QString &query) {
+  if (_query == query)
+    return;
+
+  _query = query;
+  search();
+  Q_EMIT queryChanged(_query);
+}
+
+void DockQuickOpenModel::setMaximumResults(int maximumResults) {
+  if (_maximumResults == maximumResults)
+    return;
+
+  _maximumResults = maximumResults;
+  search();
+  Q_EMIT maximumResultsChanged(_maximumResults);
+}
+
+void DockQuickOpenModel::container_dockWidgetAdded(DockWidget *widget) {
+  addEntry(widget);
+  scheduleSearch();
+}
+
+void DockQuickOpenModel::container_dockWidgetRemoved(DockWidget *widget) {
+  removeEntry(widget);
+  search();
+}
+
+void DockQuickOpenModel::dockWidget_titleChanged() {
+  auto dw = qobject_cast<DockWidget *>(sender());
+  auto i = _entryIndexes.find(dw);
+  if (i == _entryIndexes.end())
+    return;
+
+  auto &e = _entries[*i];
+  e.folded = dw->title().toCaseFolded();
+  e.mask = charMask(e.folded);
+  search();
+
+  // a row that stayed in place still shows the old title
+  for (int row = 0; row < _results.size(); ++row)
+    if (_results.at(row).widget == dw)
+      Q_EMIT dataChanged(index(row), index(row), {Qt::DisplayRole, TitleRole});
+}
+
+void DockQuickOpenModel::addEntry(DockWidget *widget) {
+  if (_entryIndexes.contains(widget))
+    return;
+
+  auto folded = widget->title().toCaseFolded();
+  _entryIndexes.insert(widget, _entries.size());
+  _entries.append({widget, folded, charMask(folded)});
+
+  connect(widget, &DockWidget::titleChanged, this, &DockQuickOpenModel::dockWidget_titleChanged);
+  connect(widget, &QObject::destroyed, this, [this, widget]() {
+    removeEntry(widget);
+    search();
+  });
+}
+
+void DockQuickOpenModel::removeEntry(DockWidget *widget) {
+  auto i = _entryIndexes.find(widget);
+  if (i == _entryIndexes.end())
+    return;
+
+  auto index = *i;
+  _entryIndexes.erase(i);
+  widget->disconnect(this);
+
+  if (index != _entries.size() - 1) {
+    _entries[index] = _entries.last();
+    _entryIndexes[_entries.at(index).widget] = index;
+  }
+  _entries.removeLast();
+}
+
+// Adds and activations come in bursts, a whole layout while loading; they
+// share one search on the next event loop pass. Removals search right away,
+// the results must not keep a dock that is gone.
+void DockQuickOpenModel::scheduleSearch() {
+  if (_searchPending)
+    return;
+  _searchPending = true;
+  QMetaObject::invokeMethod(
+      this,
+      [this]() {
+        if (_searchPending)
+          search();
+      },
+      Qt::QueuedConnection);
+}
+
+void DockQuickOpenModel::search() {
+  _searchPending = false;
+  QList<Result> results;
+  auto limit = _maximumResults > 0 ? _maximumResults : _entries.size();
+
+  if (_query.isEmpty()) {
+    // Nothing typed yet: recently used docks first
+    if (_container)
+      for (auto &dw : _container->recentDockWidgets(limit)) {
+        auto i = _entryIndexes.constFind(dw);
+        if (i != _entryIndexes.constEnd())
+          results.append({dw, *i, 0});
+      }
+  } else {
+    auto folded = _query.toCaseFolded();
+    auto mask = charMask(folded);
+
+    for (int i = 0; i < _entries.size(); ++i) {
+      const auto &e = _entries.at(i);
+      // A title missing any of the query's characters can not match
+      if ((e.mask & mask) != mask)
+        continue;
+
+      auto s = score(folded, e.folded);
+      if (s >= 0)
+        results.append({e.widget, i, s});
+    }
+
+    auto byScore = [this](const Result &a, const Result &b) {
+      if (a.score != b.score)
+        return a.score > b.score;
+      return _entries.at(a.entry).folded < _entries.at(b.entry).folded;
+    };
+
+    if (results.size() > limit) {
+      std::partial_sort(results.begin(), results.begin() + limit, results.end(), byScore);
+      results.resize(limit);
+    } else {
+      std::sort(results.begin(), results.end(), byScore);
+    }
+  }
+
+  setResults(results);
+}
+
+void DockQuickOpenModel::setResults(const QList<Result> &results) {
+  // row level updates keep the view's current row and selection while typing
+  auto oldCount = _results.size();
+  auto newCount = results.size();
+  auto common = qMin(oldCount, newCount);
+
+  if (newCount < oldCount) {
+    beginRemoveRows(QModelIndex(), newCount, oldCount - 1);
+    _results.resize(newCount);
+    endRemoveRows();
+  }
+
+  int first = -1;
+  int last = -1;
+  for (int i = 0; i < common; ++i) {
+    if (_results.at(i).widget == results.at(i).widget && _results.at(i).score == results.at(i).score)
+      continue;
+    _results[i] = results.at(i);
+    if (first < 0)
+      first = i;
+    last = i;
+  }
+  if (first >= 0)
+    Q_EMIT dataChanged(index(first), index(last));
+
+  if (newCount > oldCount) {
+    beginInsertRows(QModelIndex(), oldCount, newCount - 1);
+    _results.append(results.mid(oldCount));
+    endInsertRows();
+  }
+
+  if (newCount != oldCount)
+    Q_EMIT countChanged(newCount);
+}
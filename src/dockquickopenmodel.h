@@ -0,0 +1,85 @@
+#ifndef DOCKQUICKOPENMODEL_H
+#define DOCKQUICKOPENMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+
+class DockContainer;
+class DockWidget;
+
+class DockQuickOpenModel : public QAbstractListModel {
+  Q_OBJECT
+  Q_PROPERTY(DockContainer *container READ container WRITE setContainer NOTIFY containerChanged)
+  Q_PROPERTY(QString query READ query WRITE setQuery NOTIFY queryChanged)
+  Q_PROPERTY(int maximumResults READ maximumResults WRITE setMaximumResults NOTIFY maximumResultsChanged)
+  Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+  struct Entry {
+    DockWidget *widget;
+    QString folded;
+    quint64 mask;
+  };
+
+  // entry is only valid while searching, removals move entries around
+  struct Result {
+    DockWidget *widget;
+    int entry;
+    int score;
+  };
+
+  DockContainer *_container;
+  QString _query;
+  int _maximumResults;
+
+  // Entries are unordered, removal swaps the last one into the hole
+  QList<Entry> _entries;
+  QHash<DockWidget *, int> _entryIndexes;
+  QList<Result> _results;
+  bool _searchPending;
+
+public:
+  enum Roles { TitleRole = Qt::UserRole + 1, UniqueIdRole, DockWidgetRole, ScoreRole };
+  Q_ENUM(Roles)
+
+  DockQuickOpenModel(QObject *parent = nullptr);
+
+  DockContainer *container() const;
+  QString query() const;
+  int maximumResults() const;
+  int count() const;
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+  Q_INVOKABLE DockWidget *dockWidget(int row) const;
+  Q_INVOKABLE void activate(int row);
+
+  static int score(const QString &query, const QString &folded);
+
+public Q_SLOTS:
+  void setContainer(DockContainer *container);
+  void setQuery(const QString &query);
+  void setMaximumResults(int maximumResults);
+
+Q_SIGNALS:
+  void containerChanged(DockContainer *container);
+  void queryChanged(const QString &query);
+  void maximumResultsChanged(int maximumResults);
+  void countChanged(int count);
+
+private Q_SLOTS:
+  void container_dockWidgetAdded(DockWidget *widget);
+  void container_dockWidgetRemoved(DockWidget *widget);
+  void dockWidget_titleChanged();
+
+private:
+  static quint64 charMask(const QString &folded);
+  void addEntry(DockWidget *widget);
+  void removeEntry(DockWidget *widget);
+  void search();
+  void scheduleSearch();
+  void setResults(const QList<Result> &results);
+};
+
+#endif // DOCKQUICKOPENMODEL_H
@@ -0,0 +1,105 @@
+#include "dockrectindex.h"
+
+#include <QtMath>
+
+#include <algorithm>
+
+DockRectIndex::DockRectIndex() : _cellSize{32}, _columns{0}, _rows{0} {}
+
+void DockRectIndex::clear() {
+  _rects.clear();
+  _bounds = QRectF();
+  _columns = _rows = 0;
+  _cellStarts.clear();
+  _cellItems.clear();
+}
+
+int DockRectIndex::append(const QRectF &rect) {
+  _rects.append(rect);
+  return _rects.size() - 1;
+}
+
+void DockRectIndex::build(qreal cellSize) {
+  _cellSize = qMax<qreal>(1, cellSize);
+  _bounds = QRectF();
+  for (auto &rc : _rects)
+    _bounds = _bounds.united(rc);
+
+  _columns = qMax(1, qCeil(_bounds.width() / _cellSize));
+  _rows = qMax(1, qCeil(_bounds.height() / _cellSize));
+
+  // count, prefix sum, then fill: two passes and no per cell allocation
+  _cellStarts.fill(0, _columns * _rows + 1);
+  int left, top, right, bottom;
+  for (auto &rc : _rects) {
+    cellRange(rc, &left, &top, &right, &bottom);
+    for (int y = top; y <= bottom; ++y)
+      for (int x = left; x <= right; ++x)
+        ++_cellStarts[y * _columns + x + 1];
+  }
+
+  for (int i = 1; i < _cellStarts.size(); ++i)
+    _cellStarts[i] += _cellStarts[i - 1];
+
+  _cellItems.resize(_cellStarts.last());
+  auto fill = _cellStarts;
+  for (int i = 0; i < _rects.size(); ++i) {
+    cellRange(_rects.at(i), &left, &top, &right, &bottom);
+    for (int y = top; y <= bottom; ++y)
+      for (int x = left; x <= right; ++x)
+        _cellItems[fill[y * _columns + x]++] = i;
+  }
+}
+
+int DockRectIndex::hitTest(const QPointF &pos) const {
+  if (_cellStarts.isEmpty() || !_bounds.contains(pos))
+    return -1;
+
+  auto column = qMin(_columns - 1, int((pos.x() - _bounds.left()) / _cellSize));
+  auto row = qMin(_rows - 1, int((pos.y() - _bounds.top()) / _cellSize));
+  auto cell = row * _columns + column;
+
+  // cells list their items in append order, the first match has priority
+  for (int i = _cellStarts.at(cell); i < _cellStarts.at(cell + 1); ++i) {
+    auto index = _cellItems.at(i);
+    if (_rects.at(index).contains(pos))
+      return index;
+  }
+  return -1;
+}
+
+QList<int> DockRectIndex::intersecting(const QRectF &rect) const {
+  QList<int> items;
+  if (_cellStarts.isEmpty() || !_bounds.intersects(rect))
+    return items;
+
+  int left, top, right, bottom;
+  cellRange(rect, &left, &top, &right, &bottom);
+  for (int y = top; y <= bottom; ++y)
+    for (int x = left; x <= right; ++x) {
+      auto cell = y * _columns + x;
+      for (int i = _cellStarts.at(cell); i < _cellStarts.at(cell + 1); ++i)
+        if (_rects.at(_cellItems.at(i)).intersects(rect))
+          items.append(_cellItems.at(i));
+    }
+
+  // an item spanning several cells is found once per cell
+  std::sort(items.begin(), items.end());
+  items.erase(std::unique(items.begin(), items.end()), items.end());
+  return items;
+}
+
+int DockRectIndex::count() const {
+  return _rects.size();
+}
+
+const QRectF &DockRectIndex::at(int index) const {
+  return _rects.at(index);
+}
+
+void DockRectIndex::cellRange(const QRectF &rc, int *left, int *top, int *right, int *bottom) const {
+  *left = qBound(0, int((rc.left() - _bounds.left()) / _cellSize), _columns - 1);
+  *top = qBound(0, int((rc.top() - _bounds.top()) / _cellSize), _rows - 1);
+  *right = qBound(0, int((rc.right() - _bounds.left()) / _cellSize), _columns - 1);
+  *bottom = qBound(0, int((rc.bottom() - _bounds.top()) / _cellSize), _rows - 1);
+}
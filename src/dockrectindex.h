@@ -0,0 +1,37 @@
+#ifndef DOCKRECTINDEX_H
+#define DOCKRECTINDEX_H
+
+#include <QList>
+#include <QRectF>
+
+// Uniform grid over a set of rectangles that does not change while it is
+// queried. Items keep the order they were appended in, queries return them
+// in that order.
+class DockRectIndex {
+  QList<QRectF> _rects;
+  QRectF _bounds;
+  qreal _cellSize;
+  int _columns;
+  int _rows;
+  // per cell range into _cellItems, cell i owns [_cellStarts[i], _cellStarts[i + 1])
+  QList<int> _cellStarts;
+  QList<int> _cellItems;
+
+public:
+  DockRectIndex();
+
+  void clear();
+  int append(const QRectF &rect);
+  void build(qreal cellSize = 32);
+
+  int hitTest(const QPointF &pos) const;
+  QList<int> intersecting(const QRectF &rect) const;
+
+  int count() const;
+  const QRectF &at(int index) const;
+
+private:
+  void cellRange(const QRectF &rc, int *left, int *top, int *right, int *bottom) const;
+};
+
+#endif // DOCKRECTINDEX_H
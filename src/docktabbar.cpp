@@ -3,6 +3,7 @@
 #include "docktabbutton.h"
 #include "docktabbararrorbutton.h"
 #include "dockwidget.h"
+#include "dockwidget_p.h"
 
 #include <QPainter>
 #include <QApplication>
@@ -35,7 +36,7 @@ void DockTabBar::setCurrentIndex(int currentIndex) {
 }
 
 DockTabBar::DockTabBar(QQuickItem *parent)
-    : QQuickPaintedItem(parent), _edge{Qt::TopEdge}, m_currentIndex{-1}, _tabsStartPos{0.} {
+    : QQuickPaintedItem(parent), _edge{Qt::TopEdge}, m_currentIndex{-1}, _tabsStartPos{0.}, _tornOff{false} {
   AbstractStyle::registerThemableItem(this);
   setClip(true);
 
@@ -62,10 +63,16 @@ int DockTabBar::addTab(DockWidget *widget) {
   t->setFitSize(QFontMetrics(dockStyle->font()).horizontalAdvance(widget->title()) + 15);
   t->setY(0);
   t->setShowCloseButton(widget->closable());
+  t->setDockWidget(widget);
   _tabsSize += t->width();
   connect(t, &DockTabButton::clicked, this, &DockTabBar::tabButton_clicked);
+  connect(t, &DockTabButton::hovered, this, &DockTabBar::tabButton_hovered);
   connect(t, &DockTabButton::closeButtonClicked, this, &DockTabBar::tabButton_closeButtonClicked);
+  connect(t, &DockTabButton::dragStarted, this, &DockTabBar::tabButton_dragStarted);
+  connect(t, &DockTabButton::dragged, this, &DockTabBar::tabButton_dragged);
+  connect(t, &DockTabButton::dragEnded, this, &DockTabBar::tabButton_dragEnded);
   connect(widget, &DockWidget::titleChanged, t, &DockTabButton::setTitle);
+  _tabIndexes.insert(t, _tabs.size());
   _tabs.append(t);
   reorderTabs();
   return _tabs.count() - 1;
@@ -76,9 +83,16 @@ void DockTabBar::removeTab(int index) {
     return;
 
   auto tab = _tabs.at(index);
-  tab->setParentItem(nullptr);
-  tab->deleteLater();
+  if (tab == _dragTab) {
+    // it still holds the mouse grab of a tear-off, it goes when the drag ends
+    tab->setOpacity(0);
+  } else {
+    tab->setParentItem(nullptr);
+    tab->deleteLater();
+  }
   _tabs.removeAt(index);
+  _tabIndexes.remove(tab);
+  reindexTabs(index);
   _tabsSize -= tab->width();
 
   if (index >= _tabs.count())
@@ -87,23 +101,38 @@ void DockTabBar::removeTab(int index) {
   reorderTabs();
 }
 
+void DockTabBar::moveTab(int from, int to) {
+  if (from < 0 || from >= _tabs.count() || to < 0 || to >= _tabs.count() || from == to)
+    return;
+
+  _tabs.move(from, to);
+  reindexTabs(qMin(from, to));
+
+  // only the tabs between from and to change place
+  auto start = tabStart(qMin(from, to));
+  for (int i = qMin(from, to); i <= qMax(from, to); ++i)
+    start = placeTab(_tabs.at(i), start);
+}
+
+int DockTabBar::count() const {
+  return _tabs.count();
+}
+
+QQuickItem *DockTabBar::tabButton(int index) const {
+  return index >= 0 && index < _tabs.count() ? _tabs.at(index) : nullptr;
+}
+
 void DockTabBar::paint(QPainter *painter) {
   dockStyle->paintTabBar(painter, this);
 }
 
 void DockTabBar::reorderTabs() {
-  qreal xx = (_edge == Qt::LeftEdge ? width() : 0) + _tabsStartPos;
+  qreal xx = tabStart(0);
   for (auto btn : _tabs) {
     btn->setY(0);
     btn->setHeight(height());
     btn->setWidth(btn->fitSize());
-    if (_edge == Qt::LeftEdge) {
-      btn->setX(xx - btn->width());
-      xx -= btn->width();
-    } else {
-      btn->setX(xx);
-      xx += btn->width();
-    }
+    xx = placeTab(btn, xx);
     btn->update();
   }
 
@@ -126,24 +155,145 @@ void DockTabBar::calculateTabsSize() {
     _tabsSize += btn->width();
 }
 
+void DockTabBar::reindexTabs(int from) {
+  for (int i = qMax(0, from); i < _tabs.size(); ++i)
+    _tabIndexes[_tabs.at(i)] = i;
+}
+
+qreal DockTabBar::tabStart(int index) const {
+  if (index <= 0)
+    return (_edge == Qt::LeftEdge ? width() : 0) + _tabsStartPos;
+
+  // the slot begins where the previous tab ends
+  auto prev = _tabs.at(index - 1);
+  return _edge == Qt::LeftEdge ? prev->x() : prev->x() + prev->width();
+}
+
+qreal DockTabBar::placeTab(DockTabButton *btn, qreal start) {
+  auto next = _edge == Qt::LeftEdge ? start - btn->width() : start + btn->width();
+  // the dragged tab keeps following the mouse, its slot is still reserved
+  if (btn != _dragTab)
+    btn->setX(_edge == Qt::LeftEdge ? next : start);
+  return next;
+}
+
+void DockTabBar::tearOff(const QPointF &globalPos) {
+  auto dw = _dragTab->dockWidget();
+  if (!dw || !dw->movable())
+    return;
+
+  _tornOff = true;
+  _dragTab->setOpacity(0);
+  dw->d_func()->beginDrag(_dragOffset);
+  dw->d_func()->drag(globalPos);
+}
+
 void DockTabBar::tabButton_clicked() {
   auto btn = qobject_cast<DockTabButton *>(sender());
   if (!btn)
     return;
 
-  auto index = _tabs.indexOf(btn);
+  auto index = _tabIndexes.value(btn, -1);
   Q_EMIT tabClicked(index);
 }
 
+void DockTabBar::tabButton_hovered() {
+  auto btn = qobject_cast<DockTabButton *>(sender());
+  if (!btn)
+    return;
+
+  auto index = _tabIndexes.value(btn, -1);
+  Q_EMIT tabHovered(index);
+}
+
 void DockTabBar::tabButton_closeButtonClicked() {
   auto btn = qobject_cast<DockTabButton *>(sender());
   if (!btn)
     return;
 
-  auto index = _tabs.indexOf(btn);
+  auto index = _tabIndexes.value(btn, -1);
   Q_EMIT closeButtonClicked(index);
 }
 
+void DockTabBar::tabButton_dragStarted(const QPointF &pressPos) {
+  auto btn = qobject_cast<DockTabButton *>(sender());
+  if (!btn)
+    return;
+
+  _dragTab = btn;
+  _dragOffset = pressPos;
+  _tornOff = false;
+  btn->setZ(1);
+}
+
+void DockTabBar::tabButton_dragged(const QPointF &pos, const QPointF &globalPos) {
+  if (!_dragTab || _dragTab != sender())
+    return;
+
+  if (_tornOff) {
+    if (auto dw = _dragTab->dockWidget())
+      dw->d_func()->drag(globalPos);
+    return;
+  }
+
+  // well away from the bar the tab becomes a dock of its own
+  if (pos.y() < -height() || pos.y() > 2 * height()) {
+    tearOff(globalPos);
+    if (_tornOff)
+      return;
+  }
+
+  _dragTab->setX(pos.x() - _dragOffset.x());
+
+  // swap with a neighbour once the tab's middle passes the neighbour's middle
+  auto forward = _edge == Qt::LeftEdge ? -1. : 1.;
+  auto center = _dragTab->x() + _dragTab->width() / 2;
+  auto index = _tabIndexes.value(_dragTab, -1);
+  while (index != -1) {
+    auto to = -1;
+    for (auto step : {1, -1}) {
+      auto n = index + step;
+      if (n < 0 || n >= _tabs.count())
+        continue;
+      auto neighbour = _tabs.at(n);
+      if ((center - neighbour->x() - neighbour->width() / 2) * forward * step > 0)
+        to = n;
+    }
+    if (to == -1)
+      break;
+
+    Q_EMIT tabDragged(index, to);
+    // nobody moved it, no point in asking again
+    if (_tabIndexes.value(_dragTab, -1) == index)
+      break;
+    index = to;
+  }
+}
+
+void DockTabBar::tabButton_dragEnded() {
+  auto btn = _dragTab;
+  if (!btn || btn != sender())
+    return;
+
+  _dragTab = nullptr;
+  if (_tornOff) {
+    _tornOff = false;
+    if (auto dw = btn->dockWidget())
+      dw->d_func()->endDrag();
+  }
+
+  auto index = _tabIndexes.value(btn, -1);
+  if (index == -1) {
+    btn->setParentItem(nullptr);
+    btn->deleteLater();
+    return;
+  }
+
+  btn->setOpacity(1);
+  btn->setZ(0);
+  placeTab(btn, tabStart(index));
+}
+
 void DockTabBar::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) {
   calculateTabsSize();
   if (_tabsSize + _tabsStartPos < tabsAreaSize)
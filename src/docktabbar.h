@@ -1,6 +1,8 @@
 #ifndef DOCKTABBAR_H
 #define DOCKTABBAR_H
 
+#include <QHash>
+#include <QPointer>
 #include <QQuickPaintedItem>
 
 class DockWidget;
@@ -17,14 +19,22 @@ class DockTabBar : public QQuickPaintedItem {
   qreal _tabsSize;
 
   QList<DockTabButton *> _tabs;
+  QHash<DockTabButton *, int> _tabIndexes;
   DockTabBarArrorButton *_prevButton;
   DockTabBarArrorButton *_nextButton;
 
+  // tab following the mouse; once torn off it drives a dock drag instead
+  QPointer<DockTabButton> _dragTab;
+  QPointF _dragOffset;
+  bool _tornOff;
+
 public:
   DockTabBar(QQuickItem *parent = nullptr);
   void paint(QPainter *painter);
 
   QStringList tabs() const;
+  int count() const;
+  QQuickItem *tabButton(int index) const;
   int currentIndex() const;
 
   Qt::Edge edge() const;
@@ -34,21 +44,32 @@ private Q_SLOTS:
   void prevButton_clicked();
   void nextButton_clicked();
   void tabButton_clicked();
+  void tabButton_hovered();
   void tabButton_closeButtonClicked();
+  void tabButton_dragStarted(const QPointF &pressPos);
+  void tabButton_dragged(const QPointF &pos, const QPointF &globalPos);
+  void tabButton_dragEnded();
 
 public Q_SLOTS:
   int addTab(DockWidget *widget);
   void removeTab(int index);
+  void moveTab(int from, int to);
   void setCurrentIndex(int currentIndex);
 
 Q_SIGNALS:
   void tabClicked(int index);
+  void tabHovered(int index);
   void closeButtonClicked(int index);
+  void tabDragged(int from, int to);
   void currentIndexChanged(int currentIndex);
 
 private:
   void reorderTabs();
   void calculateTabsSize();
+  void reindexTabs(int from);
+  qreal tabStart(int index) const;
+  qreal placeTab(DockTabButton *btn, qreal start);
+  void tearOff(const QPointF &globalPos);
 
 protected:
   void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry);
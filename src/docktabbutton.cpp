@@ -6,6 +6,8 @@
 #include <QDebug>
 #include <QCursor>
 #include <QFontMetrics>
+#include <QGuiApplication>
+#include <QStyleHints>
 
 DockTabBar *DockTabButton::parentTabBar() const {
   return _parentTabBar;
@@ -22,6 +24,14 @@ void DockTabButton::setFitSize(const qreal &fitSize) {
   _fitSize = fitSize;
 }
 
+DockWidget *DockTabButton::dockWidget() const {
+  return _dockWidget;
+}
+
+void DockTabButton::setDockWidget(DockWidget *dockWidget) {
+  _dockWidget = dockWidget;
+}
+
 bool DockTabButton::showCloseButton() const {
   return _showCloseButton;
 }
@@ -32,7 +42,8 @@ void DockTabButton::setShowCloseButton(bool showCloseButton) {
 }
 
 DockTabButton::DockTabButton(QString title, DockTabBar *parent)
-    : QQuickPaintedItem(parent), _parentTabBar{parent}, _title(title), _status(Dock::Normal), _showCloseButton{true} {
+    : QQuickPaintedItem(parent), _parentTabBar{parent}, _title(title), _status(Dock::Normal), _showCloseButton{true},
+      _dragging{false} {
   setAcceptedMouseButtons(Qt::LeftButton);
   setAcceptHoverEvents(true);
   setCursor(Qt::ArrowCursor);
@@ -66,7 +77,8 @@ void DockTabButton::setChecked(bool checked) {
 }
 
 void DockTabButton::mousePressEvent(QMouseEvent *event) {
-  Q_UNUSED(event)
+  _pressPos = event->pos();
+  _dragging = false;
   if (_status == Dock::Checked)
     return;
 
@@ -74,7 +86,26 @@ void DockTabButton::mousePressEvent(QMouseEvent *event) {
   update();
 }
 
+void DockTabButton::mouseMoveEvent(QMouseEvent *event) {
+  if (!_dragging) {
+    if ((event->pos() - _pressPos).manhattanLength() < QGuiApplication::styleHints()->startDragDistance())
+      return;
+    _dragging = true;
+    Q_EMIT dragStarted(_pressPos);
+  }
+  Q_EMIT dragged(mapToItem(_parentTabBar, event->pos()), event->globalPos());
+}
+
 void DockTabButton::mouseReleaseEvent(QMouseEvent *event) {
+  if (_dragging) {
+    _dragging = false;
+    if (_status != Dock::Checked)
+      _status = Dock::Normal;
+    update();
+    Q_EMIT dragEnded();
+    return;
+  }
+
   if (_status == Dock::Checked)
     return;
 
@@ -89,6 +120,7 @@ void DockTabButton::mouseReleaseEvent(QMouseEvent *event) {
 
 void DockTabButton::hoverEnterEvent(QHoverEvent *event) {
   Q_UNUSED(event)
+  Q_EMIT hovered();
   if (_status == Dock::Checked)
     return;
 
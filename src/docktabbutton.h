@@ -1,10 +1,12 @@
 #ifndef DOCKTABBUTTON_H
 #define DOCKTABBUTTON_H
 
+#include <QPointer>
 #include <QQuickPaintedItem>
 #include "dock.h"
 
 class DockTabBar;
+class DockWidget;
 class DockWidgetHeaderButton;
 
 class DockTabButton : public QQuickPaintedItem {
@@ -15,6 +17,9 @@ class DockTabButton : public QQuickPaintedItem {
   qreal _fitSize;
   bool _showCloseButton;
   DockWidgetHeaderButton *_closeButton;
+  QPointer<DockWidget> _dockWidget;
+  QPointF _pressPos;
+  bool _dragging;
 
 public:
   DockTabButton(QString title, DockTabBar *parent = nullptr);
@@ -23,10 +28,16 @@ public:
   DockTabBar *parentTabBar() const;
   bool showCloseButton() const;
   qreal fitSize() const;
+  DockWidget *dockWidget() const;
+  void setDockWidget(DockWidget *dockWidget);
 
 Q_SIGNALS:
   void clicked();
+  void hovered();
   void closeButtonClicked();
+  void dragStarted(const QPointF &pressPos);
+  void dragged(const QPointF &pos, const QPointF &globalPos);
+  void dragEnded();
 
   // QQuickPaintedItem interface
 public Q_SLOTS:
@@ -37,6 +48,7 @@ public Q_SLOTS:
 
 protected:
   void mousePressEvent(QMouseEvent *event);
+  void mouseMoveEvent(QMouseEvent *event);
   void mouseReleaseEvent(QMouseEvent *event);
   void hoverEnterEvent(QHoverEvent *event);
   void hoverLeaveEvent(QHoverEvent *event);
@@ -6,23 +6,312 @@
 #include "dockwidgetmovehandler.h"
 #include "dockwindow.h"
 #include "dockarea.h"
+#include "dockarea_p.h"
 #include "style/abstractstyle.h"
 #include "dockcontainer.h"
+#include "dockcontentincubator.h"
 
 #include <QDebug>
 #include <QPainter>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
 #include <QQuickWindow>
 #include <QApplication>
 #include <QScopeGuard>
+#include <QTimer>
+
+// the rate layer component of each engine, compiled once and owned by the engine
+using RateLayerComponents = QHash<QQmlEngine *, QPointer<QQmlComponent>>;
+Q_GLOBAL_STATIC(RateLayerComponents, rateLayerComponents)
 
 DockWidgetPrivate::DockWidgetPrivate(DockWidget *parent)
     : q_ptr(parent)
       //      , area{Dock::Float}
       ,
       allowedAreas{Dock::AllAreas}, originalSize{200, 200}, closable{true}, resizable{true}, movable{true}, showHeader{true},
-      contentItem{nullptr}, titleBarItem{nullptr}, titleBar{nullptr}, dockWindow{nullptr},
+      contentItem{nullptr}, contentComponent{nullptr}, contentLoading{DockWidget::LoadWhenVisible},
+      asynchronousContent{true}, contentPlaceholder{nullptr}, placeholderItem{nullptr}, incubator{nullptr}, isContentLoading{false},
+      effectivelyVisible{false}, occluded{false}, suspendWhenHidden{false}, suspended{false},
+      activeUpdateRate{0}, inactiveUpdateRate{0}, rateLayer{nullptr}, rateTimer{nullptr},
+      titleBarItem{nullptr},
+      titleBar{nullptr}, dockWindow{nullptr},
       dockContainer{nullptr}, dockArea{nullptr}, isClosed{false}, autoCreateHeader{true}, isActive{false},
-      visibility{DockWidget::Closed}, detachable{false}, isDetached{false} {}
+      isMaximized{false}, normalZ{0}, visibility{DockWidget::Closed}, dragStarted{false}, dragPosPending{false},
+      detachable{false}, isDetached{false} {}
+
+bool DockWidgetPrivate::hasContentSource() const {
+  return contentComponent || contentFactory;
+}
+
+bool DockWidgetPrivate::isShown() const {
+  Q_Q(const DockWidget);
+  if (!q->window() || !q->isVisible())
+    return false;
+
+  if (area == Dock::Float || area == Dock::Detached)
+    return true;
+
+  return dockArea && visibility == DockWidget::Openned;
+}
+
+void DockWidgetPrivate::maybeLoadContent() {
+  Q_Q(DockWidget);
+  if (!hasContentSource() || !q->isComponentComplete())
+    return;
+
+  auto shown = isShown();
+  if (!contentItem && (contentLoading == DockWidget::LoadImmediately || shown))
+    q->loadContent();
+
+  if (shown && contentItem && dockContainer)
+    dockContainer->touchContent(q);
+}
+
+QQmlContext *DockWidgetPrivate::componentContext(QQmlComponent *component) const {
+  Q_Q(const DockWidget);
+  auto context = component->creationContext();
+  return context ? context : qmlContext(q);
+}
+
+void DockWidgetPrivate::setLoadedContent(QQuickItem *item) {
+  Q_Q(DockWidget);
+  q->setContentItem(item);
+
+  if (contentState.isValid()) {
+    if (item->metaObject()->indexOfMethod("restoreState(QVariant)") != -1)
+      QMetaObject::invokeMethod(item, "restoreState", Q_ARG(QVariant, contentState));
+    contentState.clear();
+  }
+}
+
+void DockWidgetPrivate::setContentLoading(bool loading) {
+  Q_Q(DockWidget);
+  if (isContentLoading == loading)
+    return;
+
+  isContentLoading = loading;
+
+  if (!loading && placeholderItem) {
+    placeholderItem->setParentItem(nullptr);
+    placeholderItem->deleteLater();
+    placeholderItem = nullptr;
+  }
+
+  if (loading && contentPlaceholder) {
+    auto obj = contentPlaceholder->create(componentContext(contentPlaceholder));
+    placeholderItem = qobject_cast<QQuickItem *>(obj);
+    if (placeholderItem) {
+      placeholderItem->setParent(q);
+      placeholderItem->setParentItem(q);
+      q->geometryChange(QRectF(), QRectF());
+    } else if (obj) {
+      obj->deleteLater();
+    }
+  }
+
+  Q_EMIT q->isContentLoadingChanged(loading);
+}
+
+void DockWidgetPrivate::startIncubation() {
+  Q_Q(DockWidget);
+  if (contentItem || incubator || !contentComponent)
+    return;
+
+  incubator = new DockContentIncubator(q);
+  contentComponent->create(*incubator, componentContext(contentComponent));
+}
+
+void DockWidgetPrivate::incubator_finished() {
+  Q_Q(DockWidget);
+  // The incubator can not be deleted from inside its own status callback
+  QMetaObject::invokeMethod(q, [this]() { finishIncubation(); }, Qt::QueuedConnection);
+}
+
+void DockWidgetPrivate::finishIncubation() {
+  Q_Q(DockWidget);
+  if (!incubator || incubator->isLoading())
+    return;
+
+  auto inc = incubator;
+  auto obj = inc->object();
+  auto item = qobject_cast<QQuickItem *>(obj);
+
+  if (inc->isError())
+    qWarning() << "Unable to create content of" << title << inc->errors();
+  else if (!item && obj)
+    obj->deleteLater();
+
+  incubator = nullptr;
+  delete inc;
+
+  setContentLoading(false);
+  if (item) {
+    item->setVisible(true);
+    setLoadedContent(item);
+  }
+
+  if (dockContainer)
+    dockContainer->incubationFinished(q);
+}
+
+void DockWidgetPrivate::cancelIncubation() {
+  Q_Q(DockWidget);
+  if (!isContentLoading)
+    return;
+
+  // Deleting a loading incubator destroys the half created object
+  auto inc = incubator;
+  incubator = nullptr;
+  delete inc;
+  setContentLoading(false);
+
+  if (dockContainer)
+    dockContainer->incubationFinished(q);
+}
+
+void DockWidgetPrivate::updateEffectiveVisibility() {
+  Q_Q(DockWidget);
+  // Anything smaller than this shows no useful content
+  constexpr qreal minimumSize = 4;
+
+  auto w = q->window();
+  auto visible = isShown() && !occluded && q->width() >= minimumSize && q->height() >= minimumSize && w && w->isVisible()
+                 && w->visibility() != QWindow::Minimized;
+
+  if (effectivelyVisible == visible)
+    return;
+
+  effectivelyVisible = visible;
+  setSuspended(suspendWhenHidden && !effectivelyVisible);
+  updateRenderRate();
+  Q_EMIT q->effectivelyVisibleChanged(effectivelyVisible);
+}
+
+void DockWidgetPrivate::setOccluded(bool occluded) {
+  if (this->occluded == occluded)
+    return;
+
+  this->occluded = occluded;
+  updateEffectiveVisibility();
+}
+
+void DockWidgetPrivate::setSuspended(bool suspended) {
+  if (this->suspended == suspended)
+    return;
+
+  this->suspended = suspended;
+
+  if (!suspended) {
+    for (auto &p : suspendedProperties)
+      if (p.first)
+        p.first->setProperty(p.second.constData(), true);
+    suspendedProperties.clear();
+    return;
+  }
+
+  for (auto &o : suspendables)
+    if (o)
+      suspendObject(o);
+}
+
+void DockWidgetPrivate::suspendObject(QObject *object) {
+  // Timers and animations stop through running, shader sources through live
+  static const QByteArray properties[] = {"running", "live"};
+  for (auto &name : properties) {
+    auto v = object->property(name.constData());
+    if (v.isValid() && v.toBool() && object->setProperty(name.constData(), false))
+      suspendedProperties.append(qMakePair(QPointer<QObject>(object), name));
+  }
+}
+
+void DockWidgetPrivate::beginDrag(const QPointF &grabOffset) {
+  Q_Q(DockWidget);
+  dragGrabOffset = grabOffset;
+  // a tab that was not the current one was hidden by its area
+  q->setVisible(true);
+  Q_EMIT q->beginMove();
+}
+
+void DockWidgetPrivate::drag(const QPointF &globalPos) {
+  Q_Q(DockWidget);
+  if (q->parentItem())
+    setDragPosition(q->parentItem()->mapFromGlobal(globalPos) - dragGrabOffset, globalPos);
+  else
+    Q_EMIT q->moving(globalPos);
+}
+
+void DockWidgetPrivate::setDragPosition(const QPointF &pos, const QPointF &globalPos) {
+  Q_Q(DockWidget);
+  // the drag session applies only the newest position, once per frame
+  dragPos = pos;
+  dragPosPending = true;
+  Q_EMIT q->moving(globalPos);
+}
+
+void DockWidgetPrivate::endDrag() {
+  Q_Q(DockWidget);
+  Q_EMIT q->moved();
+}
+
+void DockWidgetPrivate::updateRenderRate() {
+  Q_Q(DockWidget);
+  auto rate = isActive ? activeUpdateRate : inactiveUpdateRate;
+  auto limited = rate > 0 && contentItem && effectivelyVisible;
+
+  if (!limited) {
+    if (rateTimer)
+      rateTimer->stop();
+    if (rateLayer) {
+      rateLayer->setProperty("sourceItem", QVariant::fromValue<QQuickItem *>(nullptr));
+      rateLayer->setVisible(false);
+    }
+    return;
+  }
+
+  if (!rateLayer) {
+    auto engine = qmlEngine(q);
+    if (!engine)
+      return;
+
+    // A frozen texture of the content, refreshed by the timer instead of every frame
+    auto components = rateLayerComponents();
+    QQmlComponent *component = components->value(engine);
+    if (!component) {
+      // entries of engines destroyed since go first
+      for (auto i = components->begin(); i != components->end();)
+        i = i.value() ? std::next(i) : components->erase(i);
+      component = new QQmlComponent(engine, engine);
+      component->setData("import QtQuick\nShaderEffectSource { live: false; hideSource: true }", QUrl());
+      components->insert(engine, component);
+    }
+    rateLayer = qobject_cast<QQuickItem *>(component->create(qmlContext(q)));
+    if (!rateLayer) {
+      qWarning() << "Unable to create update rate layer" << component->errors();
+      return;
+    }
+    rateLayer->setParent(q);
+    rateLayer->setParentItem(q);
+
+    rateTimer = new QTimer(q);
+    QObject::connect(rateTimer, &QTimer::timeout, q, [this]() { rateLayer_refresh(); });
+  }
+
+  rateLayer->setProperty("sourceItem", QVariant::fromValue(contentItem));
+  rateLayer->setPosition(contentItem->position());
+  rateLayer->setSize(contentItem->size());
+  rateLayer->setZ(contentItem->z());
+  rateLayer->setVisible(true);
+  rateLayer_refresh();
+
+  rateTimer->setInterval(qMax(1, qRound(1000 / rate)));
+  rateTimer->start();
+}
+
+void DockWidgetPrivate::rateLayer_refresh() {
+  if (rateLayer)
+    QMetaObject::invokeMethod(rateLayer, "scheduleUpdate");
+}
 
 DockArea *DockWidget::dockArea() const {
   Q_D(const DockWidget);
@@ -70,13 +359,13 @@ void DockWidget::paint(QPainter *painter) {
 
 DockWidget::DockWidget(QQuickItem *parent) : QQuickPaintedItem(parent), d_ptr(new DockWidgetPrivate(this)) {
   setClip(true);
-  setAcceptHoverEvents(true);
   setAcceptedMouseButtons(Qt::LeftButton);
   AbstractStyle::registerThemableItem(this);
 }
 
 DockWidget::~DockWidget() {
   Q_D(DockWidget);
+  delete d->incubator;
   d->dockWindow->deleteLater();
   delete d;
 }
@@ -131,6 +420,83 @@ void DockWidget::restoreSize() {
   setSize(d->originalSize);
 }
 
+void DockWidget::maximize() {
+  Q_D(DockWidget);
+  if (d->isMaximized || !d->dockContainer || d->area == Dock::Detached)
+    return;
+
+  d->dockContainer->maximizeDockWidget(this);
+}
+
+void DockWidget::restore() {
+  Q_D(DockWidget);
+  if (!d->isMaximized || !d->dockContainer)
+    return;
+
+  d->dockContainer->restoreDockWidget();
+}
+
+void DockWidget::loadContent() {
+  Q_D(DockWidget);
+  if (d->contentItem || !d->hasContentSource())
+    return;
+
+  if (!d->contentFactory && d->asynchronousContent) {
+    d->setContentLoading(true);
+    if (d->incubator)
+      return;
+
+    // Queued again when shown, which moves the dock to the front
+    if (d->dockContainer)
+      d->dockContainer->queueIncubation(this);
+    else
+      d->startIncubation();
+    return;
+  }
+
+  QQuickItem *item{nullptr};
+  if (d->contentFactory) {
+    item = d->contentFactory(this);
+  } else {
+    auto obj = d->contentComponent->beginCreate(d->componentContext(d->contentComponent));
+    item = qobject_cast<QQuickItem *>(obj);
+    if (item) {
+      item->setParent(this);
+      item->setParentItem(this);
+    }
+    d->contentComponent->completeCreate();
+
+    if (!item) {
+      if (obj)
+        obj->deleteLater();
+      qWarning() << "Unable to create content of" << d->title << d->contentComponent->errors();
+      return;
+    }
+  }
+
+  if (!item)
+    return;
+
+  d->setLoadedContent(item);
+}
+
+void DockWidget::unloadContent() {
+  Q_D(DockWidget);
+  d->cancelIncubation();
+
+  // Content set directly through contentItem can not be created again
+  if (!d->contentItem || !d->hasContentSource())
+    return;
+
+  auto item = d->contentItem;
+  if (item->metaObject()->indexOfMethod("saveState()") != -1)
+    QMetaObject::invokeMethod(item, "saveState", Q_RETURN_ARG(QVariant, d->contentState));
+
+  setContentItem(nullptr);
+  item->setParentItem(nullptr);
+  item->deleteLater();
+}
+
 void DockWidget::setArea(Dock::Area area) {
   Q_D(DockWidget);
 
@@ -157,6 +523,9 @@ void DockWidget::setArea(Dock::Area area) {
     d->dockWindow->hide();
   }
   d->area = area;
+  setAcceptHoverEvents(d->area == Dock::Detached);
+  d->maybeLoadContent();
+  d->updateEffectiveVisibility();
   Q_EMIT areaChanged(d->area);
 }
 
@@ -220,6 +589,12 @@ void DockWidget::setContentItem(QQuickItem *contentItem) {
 
   d->contentItem = contentItem;
 
+  if (!d->contentItem) {
+    d->updateRenderRate();
+    Q_EMIT contentItemChanged(nullptr);
+    return;
+  }
+
   d->contentItem->setParentItem(this);
   //    d->contentItem->setPosition(QPointF(
   //                                   dockStyle->widgetPadding(),
@@ -227,9 +602,93 @@ void DockWidget::setContentItem(QQuickItem *contentItem) {
   //                                    +dockStyle->widgetPadding()
   //                                   ));
   geometryChange(QRectF(), QRectF());
+  d->updateRenderRate();
   Q_EMIT contentItemChanged(d->contentItem);
 }
 
+void DockWidget::setContentComponent(QQmlComponent *contentComponent) {
+  Q_D(DockWidget);
+  if (d->contentComponent == contentComponent)
+    return;
+
+  d->contentComponent = contentComponent;
+  d->maybeLoadContent();
+  Q_EMIT contentComponentChanged(d->contentComponent);
+}
+
+void DockWidget::setContentLoading(ContentLoading contentLoading) {
+  Q_D(DockWidget);
+  if (d->contentLoading == contentLoading)
+    return;
+
+  d->contentLoading = contentLoading;
+  d->maybeLoadContent();
+  Q_EMIT contentLoadingChanged(d->contentLoading);
+}
+
+void DockWidget::setAsynchronousContent(bool asynchronousContent) {
+  Q_D(DockWidget);
+  if (d->asynchronousContent == asynchronousContent)
+    return;
+
+  d->asynchronousContent = asynchronousContent;
+  Q_EMIT asynchronousContentChanged(d->asynchronousContent);
+}
+
+void DockWidget::setContentPlaceholder(QQmlComponent *contentPlaceholder) {
+  Q_D(DockWidget);
+  if (d->contentPlaceholder == contentPlaceholder)
+    return;
+
+  d->contentPlaceholder = contentPlaceholder;
+  Q_EMIT contentPlaceholderChanged(d->contentPlaceholder);
+}
+
+void DockWidget::setSuspendWhenHidden(bool suspendWhenHidden) {
+  Q_D(DockWidget);
+  if (d->suspendWhenHidden == suspendWhenHidden)
+    return;
+
+  d->suspendWhenHidden = suspendWhenHidden;
+  d->setSuspended(d->suspendWhenHidden && !d->effectivelyVisible);
+  Q_EMIT suspendWhenHiddenChanged(d->suspendWhenHidden);
+}
+
+void DockWidget::setActiveUpdateRate(qreal activeUpdateRate) {
+  Q_D(DockWidget);
+  if (qFuzzyCompare(d->activeUpdateRate, activeUpdateRate))
+    return;
+
+  d->activeUpdateRate = activeUpdateRate;
+  d->updateRenderRate();
+  Q_EMIT activeUpdateRateChanged(d->activeUpdateRate);
+}
+
+void DockWidget::setInactiveUpdateRate(qreal inactiveUpdateRate) {
+  Q_D(DockWidget);
+  if (qFuzzyCompare(d->inactiveUpdateRate, inactiveUpdateRate))
+    return;
+
+  d->inactiveUpdateRate = inactiveUpdateRate;
+  d->updateRenderRate();
+  Q_EMIT inactiveUpdateRateChanged(d->inactiveUpdateRate);
+}
+
+void DockWidget::setContentFactory(ContentFactory factory) {
+  Q_D(DockWidget);
+  d->contentFactory = std::move(factory);
+  d->maybeLoadContent();
+}
+
+void DockWidget::setUniqueId(const QString &uniqueId) {
+  Q_D(DockWidget);
+  if (d->uniqueId == uniqueId)
+    return;
+
+  d->uniqueId = uniqueId;
+  Q_EMIT uniqueIdChanged(d->uniqueId);
+}
+
 void DockWidget::setTitle(QString title) {
   Q_D(DockWidget);
   if (d->title == title)
@@ -279,10 +738,31 @@ void DockWidget::setIsActive(bool isActive) {
     return;
 
   d->isActive = isActive;
+  d->updateRenderRate();
   update();
   Q_EMIT isActiveChanged(d->isActive);
 }
 
+void DockWidget::setMaximized(bool maximized) {
+  Q_D(DockWidget);
+  if (d->isMaximized == maximized)
+    return;
+
+  if (maximized) {
+    d->normalGeometry = QRectF(position(), size());
+    d->normalZ = z();
+  }
+
+  d->isMaximized = maximized;
+
+  if (!maximized) {
+    setZ(d->normalZ);
+    setPosition(d->normalGeometry.topLeft());
+    setSize(d->normalGeometry.size());
+  }
+  Q_EMIT isMaximizedChanged(d->isMaximized);
+}
+
 void DockWidget::header_moveStarted() {
   //    if (isDetached)
   //        d->dockWindow->startSystemMove();
@@ -291,15 +771,9 @@ void DockWidget::header_moveStarted() {
   Q_EMIT beginMove();
 }
 
-void DockWidget::header_moving(const QPointF &windowPos, const QPointF &cursorPos) {
+void DockWidget::header_moving(const QPointF &windowPos, const QPointF &globalPos) {
   Q_D(DockWidget);
-  if (d->area == Dock::Detached) {
-    Q_EMIT moving(d->dockContainer->mapFromGlobal(cursorPos));
-    d->dockWindow->setPosition(windowPos.toPoint());
-  } else {
-    setPosition(windowPos);
-    Q_EMIT moving(cursorPos);
-  }
+  d->setDragPosition(windowPos, globalPos);
 }
 
 void DockWidget::header_moveEnded() {
@@ -308,48 +782,41 @@ void DockWidget::header_moveEnded() {
 
 bool DockWidget::childMouseEventFilter(QQuickItem *item, QEvent *e) {
   Q_D(DockWidget);
-  static QPointF _lastMousePos;
-  static QPointF _lastChildPos;
-  static bool _moveEmitted = false;
 
   if (item != d->titleBar || !d->movable) {
     return false;
   }
 
-  auto me = static_cast<QMouseEvent *>(e);
-  if (d->isDetached) {
-    if (me->button() == Qt::LeftButton)
-      d->dockWindow->startSystemMove();
-    return true;
-  }
+  // a detached dock moves its window by hand instead of a system move, so
+  // the drag can end over a container and dock there again
+  auto detached = d->area == Dock::Detached;
 
   switch (e->type()) {
-  case QEvent::MouseButtonPress:
-    _lastMousePos = me->windowPos();
-    _lastChildPos = position();
-    Q_EMIT beginMove();
-    //        detach();
-    _moveEmitted = false;
+  case QEvent::MouseButtonPress: {
+    auto me = static_cast<QMouseEvent *>(e);
+    d->dragPressPos = detached ? me->globalPosition() : me->scenePosition();
+    d->dragStartPos = detached ? QPointF(d->dockWindow->position()) : position();
+    d->dragStarted = false;
     break;
+  }
 
   case QEvent::MouseMove: {
-    if (_moveEmitted) {
-      Q_EMIT moving(me->localPos());
-    } else {
+    auto me = static_cast<QMouseEvent *>(e);
+    // the drag starts with the first move, a click on the title bar is no drag
+    if (!d->dragStarted) {
+      d->dragStarted = true;
       Q_EMIT beginMove();
-      _moveEmitted = true;
     }
-    auto pt = _lastChildPos + (me->windowPos() - _lastMousePos);
-
-    setPosition(pt);
-    Q_EMIT moving(pt + me->pos());
+    auto mousePos = detached ? me->globalPosition() : me->scenePosition();
+    d->setDragPosition(d->dragStartPos + (mousePos - d->dragPressPos), me->globalPosition());
     break;
   }
 
   case QEvent::MouseButtonRelease:
-    Q_EMIT moved();
+    if (d->dragStarted)
+      Q_EMIT moved();
+    d->dragStarted = false;
     break;
-    ;
 
   default:
     break;
@@ -359,6 +826,18 @@ bool DockWidget::childMouseEventFilter(QQuickItem *item, QEvent *e) {
 }
 
 void DockWidget::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &data) {
+  Q_D(DockWidget);
+  if (change == QQuickItem::ItemVisibleHasChanged && data.boolValue)
+    d->maybeLoadContent();
+
+  if (change == QQuickItem::ItemSceneChange) {
+    disconnect(d->windowConnection);
+    if (data.window)
+      d->windowConnection = connect(data.window, &QWindow::visibilityChanged, this, [d]() { d->updateEffectiveVisibility(); });
+  }
+
+  if (change == QQuickItem::ItemVisibleHasChanged || change == QQuickItem::ItemSceneChange)
+    d->updateEffectiveVisibility();
   QQuickItem::itemChange(change, data);
 }
 
@@ -368,7 +847,10 @@ void DockWidget::geometryChange(const QRectF &newGeometry, const QRectF &oldGeom
   if (!isComponentComplete())
     return;
 
-  if (d->area == Dock::Float) {
+  if (newGeometry.size() != oldGeometry.size())
+    d->updateEffectiveVisibility();
+
+  if (d->area == Dock::Float && !d->isMaximized) {
     d->originalSize = newGeometry.size();
   }
 
@@ -395,6 +877,14 @@ void DockWidget::geometryChange(const QRectF &newGeometry, const QRectF &oldGeom
     d->contentItem->setWidth(rc.width());
     d->contentItem->setHeight(rc.height() - titlebarHeight);
   }
+  if (d->rateLayer && d->rateLayer->isVisible()) {
+    d->rateLayer->setPosition(QPointF(rc.left(), rc.top() + titlebarHeight));
+    d->rateLayer->setSize(QSizeF(rc.width(), rc.height() - titlebarHeight));
+  }
+  if (d->placeholderItem) {
+    d->placeholderItem->setPosition(QPointF(rc.left(), rc.top() + titlebarHeight));
+    d->placeholderItem->setSize(QSizeF(rc.width(), rc.height() - titlebarHeight));
+  }
 }
 
 bool DockWidget::getIsDetached() const {
@@ -437,6 +927,8 @@ void DockWidget::componentComplete() {
   }
   setSize(QSizeF(200, 200));
   QQuickPaintedItem::componentComplete();
+
+  d->maybeLoadContent();
 }
 
 bool DockWidget::isActive() const {
@@ -456,91 +948,146 @@ DockContainer *DockWidget::dockContainer() const {
 void DockWidget::setDockContainer(DockContainer *dockContainer) {
   Q_D(DockWidget);
   setParentItem(dockContainer);
+  if (d->dockContainer == dockContainer)
+    return;
+
   d->dockContainer = dockContainer;
+  Q_EMIT dockContainerChanged(d->dockContainer);
+}
+
+DockWidgetAttached *DockWidget::qmlAttachedProperties(QObject *object) {
+  return new DockWidgetAttached(object);
 }
 
 void DockWidget::hoverMoveEvent(QHoverEvent *event) {
   Q_D(DockWidget);
-  if (d->area != Dock::Float && d->area != Dock::Detached) {
-    setCursor(Qt::ArrowCursor);
+
+  // hover is only enabled while detached, the grip layer of the container
+  // takes care of docked and floating widgets
+  if (d->area != Dock::Detached)
     return;
-  }
-  QCursor cursor = Qt::ArrowCursor;
+
+  auto shape = Qt::ArrowCursor;
   auto b = 10;
   if (event->pos().x() < b && event->pos().y() < b)
-    cursor = Qt::SizeFDiagCursor;
+    shape = Qt::SizeFDiagCursor;
   else if (event->pos().x() >= width() - b && event->pos().y() >= height() - b)
-    cursor = Qt::SizeFDiagCursor;
+    shape = Qt::SizeFDiagCursor;
   else if (event->pos().x() >= width() - b && event->pos().y() < b)
-    cursor = Qt::SizeBDiagCursor;
+    shape = Qt::SizeBDiagCursor;
   else if (event->pos().x() < b && event->pos().y() >= height() - b)
-    cursor = Qt::SizeBDiagCursor;
+    shape = Qt::SizeBDiagCursor;
   else if (event->pos().x() < b || event->pos().x() >= width() - b)
-    cursor = Qt::SizeHorCursor;
+    shape = Qt::SizeHorCursor;
   else if (event->pos().y() < b || event->pos().y() >= height() - b)
-    cursor = Qt::SizeVerCursor;
+    shape = Qt::SizeVerCursor;
 
-  setCursor(cursor);
+  if (cursor().shape() != shape)
+    setCursor(shape);
 }
 
 void DockWidget::mousePressEvent(QMouseEvent *event) {
   Q_D(DockWidget);
-  d->resizeEdge = 0;
-  auto b = 10;
-  if (event->pos().x() < b) {
-    d->resizeEdge |= Qt::LeftEdge;
-  }
-  if (event->pos().x() >= width() - b) {
-    d->resizeEdge |= Qt::RightEdge;
-  }
-  if (event->pos().y() < b) {
-    d->resizeEdge |= Qt::TopEdge;
-  }
-  if (event->pos().y() >= height() - b) {
-    d->resizeEdge |= Qt::BottomEdge;
-  }
-
-  if (d->resizeEdge) {
-    if (d->isDetached && d->dockWindow) {
-      d->dockWindow->startSystemResize((Qt::Edge)d->resizeEdge);
-      event->ignore();
-    } else {
-      event->accept();
-    }
-    d->rectBeforeResize = QRectF(position(), size());
-    d->resizeMousePos = event->windowPos();
-  } else {
+  if (!d->isDetached || !d->dockWindow) {
     event->ignore();
+    return;
   }
+
+  Qt::Edges resizeEdge;
+  auto b = 10;
+  if (event->pos().x() < b)
+    resizeEdge |= Qt::LeftEdge;
+  if (event->pos().x() >= width() - b)
+    resizeEdge |= Qt::RightEdge;
+  if (event->pos().y() < b)
+    resizeEdge |= Qt::TopEdge;
+  if (event->pos().y() >= height() - b)
+    resizeEdge |= Qt::BottomEdge;
+
+  if (resizeEdge)
+    d->dockWindow->startSystemResize(resizeEdge);
+  event->ignore();
 }
 
-void DockWidget::mouseMoveEvent(QMouseEvent *event) {
+void DockWidget::hoverLeaveEvent(QHoverEvent *event) {
   Q_D(DockWidget);
-  QRectF rc(position(), size());
-  if (d->resizeEdge & Qt::LeftEdge)
-    rc.setLeft(d->rectBeforeResize.left() + event->windowPos().x() - d->resizeMousePos.x());
+  setCursor(Qt::ArrowCursor);
 
-  if (d->resizeEdge & Qt::TopEdge)
-    rc.setTop(d->rectBeforeResize.top() + event->windowPos().y() - d->resizeMousePos.y());
+  // a panel opened by hovering its tab closes once the pointer is off it
+  if (d->dockArea)
+    d->dockArea->d_func()->pointerLeft(mapToScene(event->position()));
+}
 
-  if (d->resizeEdge & Qt::RightEdge)
-    rc.setRight(d->rectBeforeResize.right() + event->windowPos().x() - d->resizeMousePos.x());
+QQuickItem *DockWidget::contentItem() const {
+  Q_D(const DockWidget);
+  return d->contentItem;
+}
 
-  if (d->resizeEdge & Qt::BottomEdge)
-    rc.setBottom(d->rectBeforeResize.bottom() + event->windowPos().y() - d->resizeMousePos.y());
+bool DockWidget::asynchronousContent() const {
+  Q_D(const DockWidget);
+  return d->asynchronousContent;
+}
 
-  setPosition(rc.topLeft());
-  setSize(rc.size());
+QQmlComponent *DockWidget::contentPlaceholder() const {
+  Q_D(const DockWidget);
+  return d->contentPlaceholder;
 }
 
-void DockWidget::hoverLeaveEvent(QHoverEvent *event) {
-  Q_UNUSED(event);
-  setCursor(Qt::ArrowCursor);
+bool DockWidget::effectivelyVisible() const {
+  Q_D(const DockWidget);
+  return d->effectivelyVisible;
 }
 
-QQuickItem *DockWidget::contentItem() const {
+qreal DockWidget::activeUpdateRate() const {
   Q_D(const DockWidget);
-  return d->contentItem;
+  return d->activeUpdateRate;
+}
+
+qreal DockWidget::inactiveUpdateRate() const {
+  Q_D(const DockWidget);
+  return d->inactiveUpdateRate;
+}
+
+bool DockWidget::suspendWhenHidden() const {
+  Q_D(const DockWidget);
+  return d->suspendWhenHidden;
+}
+
+void DockWidget::registerSuspendable(QObject *object) {
+  Q_D(DockWidget);
+  if (!object || d->suspendables.contains(object))
+    return;
+
+  d->suspendables.append(object);
+  if (d->suspended)
+    d->suspendObject(object);
+}
+
+void DockWidget::unregisterSuspendable(QObject *object) {
+  Q_D(DockWidget);
+  d->suspendables.removeAll(object);
+  for (int i = d->suspendedProperties.size() - 1; i >= 0; --i) {
+    auto &p = d->suspendedProperties[i];
+    if (p.first != object)
+      continue;
+    object->setProperty(p.second.constData(), true);
+    d->suspendedProperties.removeAt(i);
+  }
+}
+
+bool DockWidget::isContentLoading() const {
+  Q_D(const DockWidget);
+  return d->isContentLoading;
+}
+
+QQmlComponent *DockWidget::contentComponent() const {
+  Q_D(const DockWidget);
+  return d->contentComponent;
+}
+
+DockWidget::ContentLoading DockWidget::contentLoading() const {
+  Q_D(const DockWidget);
+  return d->contentLoading;
 }
 
 QString DockWidget::title() const {
@@ -548,6 +1095,16 @@ QString DockWidget::title() const {
   return d->title;
 }
 
+QString DockWidget::uniqueId() const {
+  Q_D(const DockWidget);
+  return d->uniqueId;
+}
+
+bool DockWidget::isMaximized() const {
+  Q_D(const DockWidget);
+  return d->isMaximized;
+}
+
 DockWidget::DockWidgetVisibility DockWidget::visibility() const {
   Q_D(const DockWidget);
   return d->visibility;
@@ -559,5 +1116,7 @@ void DockWidget::setVisibility(DockWidgetVisibility newVisibility) {
   if (d->visibility == newVisibility)
     return;
   d->visibility = newVisibility;
+  d->maybeLoadContent();
+  d->updateEffectiveVisibility();
   Q_EMIT visibilityChanged();
 }
@@ -3,8 +3,12 @@
 
 #include <QJSValue>
 #include <QQuickPaintedItem>
+#include <qqml.h>
+#include <functional>
 #include "dock.h"
+#include "dockwidgetattached.h"
 
+class QQmlComponent;
 class DockArea;
 class DockWidgetHeader;
 class DockWindow;
@@ -16,6 +20,7 @@ class DockWidget : public QQuickPaintedItem {
 
   Q_DECLARE_PRIVATE(DockWidget)
   DockWidgetPrivate *d_ptr;
+  QML_ATTACHED(DockWidgetAttached)
 
   Q_PROPERTY(Dock::Area area READ area WRITE setArea NOTIFY areaChanged)
   Q_PROPERTY(bool closable READ closable WRITE setClosable NOTIFY closableChanged)
@@ -24,12 +29,25 @@ class DockWidget : public QQuickPaintedItem {
   Q_PROPERTY(bool showHeader READ showHeader WRITE setShowHeader NOTIFY showHeaderChanged)
   Q_PROPERTY(bool detachable READ detachable WRITE setDetachable NOTIFY detachableChanged)
   Q_PROPERTY(QQuickItem *contentItem READ contentItem WRITE setContentItem NOTIFY contentItemChanged FINAL)
+  Q_PROPERTY(QQmlComponent *contentComponent READ contentComponent WRITE setContentComponent NOTIFY contentComponentChanged)
+  Q_PROPERTY(ContentLoading contentLoading READ contentLoading WRITE setContentLoading NOTIFY contentLoadingChanged)
+  Q_PROPERTY(bool asynchronousContent READ asynchronousContent WRITE setAsynchronousContent NOTIFY
+                 asynchronousContentChanged)
+  Q_PROPERTY(QQmlComponent *contentPlaceholder READ contentPlaceholder WRITE setContentPlaceholder NOTIFY
+                 contentPlaceholderChanged)
+  Q_PROPERTY(bool isContentLoading READ isContentLoading NOTIFY isContentLoadingChanged)
   Q_PROPERTY(QQuickItem *titleBar READ titleBar WRITE setTitleBar NOTIFY titleBarChanged)
   Q_PROPERTY(QString title READ title WRITE setTitle NOTIFY titleChanged)
+  Q_PROPERTY(QString uniqueId READ uniqueId WRITE setUniqueId NOTIFY uniqueIdChanged)
   Q_PROPERTY(Dock::Areas allowedAreas READ allowedAreas WRITE setAllowedAreas NOTIFY allowedAreasChanged)
   Q_PROPERTY(bool isActive READ isActive WRITE setIsActive NOTIFY isActiveChanged)
   Q_PROPERTY(QJSValue closeEvent READ closeEvent WRITE setCloseEvent NOTIFY closeEventChanged)
   Q_PROPERTY(DockWidgetVisibility visibility READ visibility WRITE setVisibility NOTIFY visibilityChanged)
+  Q_PROPERTY(bool isMaximized READ isMaximized NOTIFY isMaximizedChanged)
+  Q_PROPERTY(bool effectivelyVisible READ effectivelyVisible NOTIFY effectivelyVisibleChanged)
+  Q_PROPERTY(bool suspendWhenHidden READ suspendWhenHidden WRITE setSuspendWhenHidden NOTIFY suspendWhenHiddenChanged)
+  Q_PROPERTY(qreal activeUpdateRate READ activeUpdateRate WRITE setActiveUpdateRate NOTIFY activeUpdateRateChanged)
+  Q_PROPERTY(qreal inactiveUpdateRate READ inactiveUpdateRate WRITE setInactiveUpdateRate NOTIFY inactiveUpdateRateChanged)
 
   //    Q_PROPERTY(DockWidgetFlags flags READ flags WRITE setFlags NOTIFY flagsChanged)
 
@@ -37,6 +55,11 @@ public:
   enum DockWidgetVisibility { Openned, Active, Hidden, Closed };
   Q_ENUM(DockWidgetVisibility)
 
+  enum ContentLoading { LoadWhenVisible, PreloadWhenIdle, LoadImmediately };
+  Q_ENUM(ContentLoading)
+
+  using ContentFactory = std::function<QQuickItem *(DockWidget *)>;
+
   enum DockWidgetFlag { Movable, Detachable, Resizable };
   Q_DECLARE_FLAGS(DockWidgetFlags, DockWidgetFlag)
   Q_FLAG(DockWidgetFlags)
@@ -53,12 +76,28 @@ public:
   bool detachable() const;
   void paint(QPainter *painter) override;
   QQuickItem *contentItem() const;
+  QQmlComponent *contentComponent() const;
+  ContentLoading contentLoading() const;
+  bool asynchronousContent() const;
+  QQmlComponent *contentPlaceholder() const;
+  bool isContentLoading() const;
+  bool effectivelyVisible() const;
+  bool suspendWhenHidden() const;
+  qreal activeUpdateRate() const;
+  qreal inactiveUpdateRate() const;
+
+  Q_INVOKABLE void registerSuspendable(QObject *object);
+  Q_INVOKABLE void unregisterSuspendable(QObject *object);
+  void setContentFactory(ContentFactory factory);
 
   QString title() const;
+  QString uniqueId() const;
 
   DockContainer *dockContainer() const;
   void setDockContainer(DockContainer *dockContainer);
 
+  static DockWidgetAttached *qmlAttachedProperties(QObject *object);
+
   bool getIsDetached() const;
 
   Dock::Areas allowedAreas() const;
@@ -74,6 +113,8 @@ public:
   DockWidgetVisibility visibility() const;
   void setVisibility(DockWidgetVisibility newVisibility);
 
+  bool isMaximized() const;
+
 public Q_SLOTS:
   Q_DECL_DEPRECATED
   void detach();
@@ -82,6 +123,10 @@ public Q_SLOTS:
   void open();
   void close();
   void restoreSize();
+  void maximize();
+  void restore();
+  void loadContent();
+  void unloadContent();
 
   void setDockArea(DockArea *dockArea);
   void setArea(Dock::Area area);
@@ -92,8 +137,16 @@ public Q_SLOTS:
   void setDetachable(bool detachable);
 
   void setContentItem(QQuickItem *contentItem);
+  void setContentComponent(QQmlComponent *contentComponent);
+  void setContentLoading(ContentLoading contentLoading);
+  void setAsynchronousContent(bool asynchronousContent);
+  void setContentPlaceholder(QQmlComponent *contentPlaceholder);
+  void setSuspendWhenHidden(bool suspendWhenHidden);
+  void setActiveUpdateRate(qreal activeUpdateRate);
+  void setInactiveUpdateRate(qreal inactiveUpdateRate);
 
   void setTitle(QString title);
+  void setUniqueId(const QString &uniqueId);
 
   void setAllowedAreas(Dock::Areas allowedAreas);
 
@@ -103,7 +156,7 @@ public Q_SLOTS:
 
 private Q_SLOTS:
   void header_moveStarted();
-  void header_moving(const QPointF &windowPos, const QPointF &cursorPos);
+  void header_moving(const QPointF &windowPos, const QPointF &globalPos);
   void header_moveEnded();
 
 protected:
@@ -113,11 +166,10 @@ protected:
   void hoverMoveEvent(QHoverEvent *event) override;
   void hoverLeaveEvent(QHoverEvent *event) override;
   void mousePressEvent(QMouseEvent *event) override;
-  void mouseMoveEvent(QMouseEvent *event) override;
 
 Q_SIGNALS:
   void beginMove();
-  void moving(const QPointF &pt);
+  void moving(const QPointF &globalPos);
   void moved();
   void closed();
   void opened();
@@ -128,21 +180,36 @@ Q_SIGNALS:
   void showHeaderChanged(bool showHeader);
   void detachableChanged(bool detachable);
   void contentItemChanged(QQuickItem *contentItem);
+  void contentComponentChanged(QQmlComponent *contentComponent);
+  void contentLoadingChanged(ContentLoading contentLoading);
+  void asynchronousContentChanged(bool asynchronousContent);
+  void contentPlaceholderChanged(QQmlComponent *contentPlaceholder);
+  void isContentLoadingChanged(bool isContentLoading);
+  void effectivelyVisibleChanged(bool effectivelyVisible);
+  void suspendWhenHiddenChanged(bool suspendWhenHidden);
+  void activeUpdateRateChanged(qreal activeUpdateRate);
+  void inactiveUpdateRateChanged(qreal inactiveUpdateRate);
   void titleChanged(QString title);
+  void uniqueIdChanged(const QString &uniqueId);
+  void dockContainerChanged(DockContainer *dockContainer);
   void allowedAreasChanged(Dock::Areas allowedAreas);
   void titleBarChanged(QQuickItem *titleBar);
   void isActiveChanged(bool isActive);
   void closeEventChanged(QJSValue closeEvent);
   void visibilityChanged();
+  void isMaximizedChanged(bool isMaximized);
 
 private:
   void setIsActive(bool isActive);
+  void setMaximized(bool maximized);
 
   friend class DockContainer;
   friend class DockArea;
   QJSValue m_closeEvent;
 
   friend class DockWidgetHeader;
+  friend class DockContentIncubator;
+  friend class DockTabBar;
 };
 
 #endif // DOCKWIDGET_H
@@ -4,8 +4,10 @@
 #include "dock.h"
 #include "dockwidget.h"
 
+#include <QPointer>
 #include <QRectF>
 #include <QSizeF>
+#include <QVariant>
 
 class DockWidget;
 class DockWindow;
@@ -13,6 +15,10 @@ class QQuickItem;
 class DockContainer;
 class DockArea;
 class DockWidgetHeader;
+class QQmlComponent;
+class QQmlContext;
+class DockContentIncubator;
+class QTimer;
 
 class DockWidgetPrivate {
   DockWidget *q_ptr;
@@ -32,8 +38,31 @@ public:
   bool showHeader;
 
   QString title;
+  QString uniqueId;
 
   QQuickItem *contentItem;
+  QQmlComponent *contentComponent;
+  DockWidget::ContentFactory contentFactory;
+  DockWidget::ContentLoading contentLoading;
+  QVariant contentState;
+  bool asynchronousContent;
+  QQmlComponent *contentPlaceholder;
+  QQuickItem *placeholderItem;
+  DockContentIncubator *incubator;
+  bool isContentLoading;
+
+  bool effectivelyVisible;
+  bool occluded;
+  bool suspendWhenHidden;
+  bool suspended;
+  QList<QPointer<QObject>> suspendables;
+  QList<QPair<QPointer<QObject>, QByteArray>> suspendedProperties;
+  QMetaObject::Connection windowConnection;
+
+  qreal activeUpdateRate;
+  qreal inactiveUpdateRate;
+  QQuickItem *rateLayer;
+  QTimer *rateTimer;
   QQuickItem *titleBarItem;
   DockWidgetHeader *titleBar;
   DockWindow *dockWindow;
@@ -42,13 +71,50 @@ public:
   DockWidget::DockWidgetVisibility visibility;
 
   bool isClosed;
-  int resizeEdge;
-  QRectF rectBeforeResize;
-  QPointF resizeMousePos;
 
   bool autoCreateHeader;
   bool isActive;
 
+  bool isMaximized;
+  QRectF normalGeometry;
+  qreal normalZ;
+
+  // title bar drag through childMouseEventFilter, in scene coordinates or
+  // global ones for a detached dock
+  QPointF dragPressPos;
+  QPointF dragStartPos;
+  bool dragStarted;
+  // newest position of a drag not yet applied, for the parent item or for
+  // the window of a detached dock
+  QPointF dragPos;
+  bool dragPosPending;
+  // where the mouse holds the widget while a torn off tab drags it
+  QPointF dragGrabOffset;
+
+  bool hasContentSource() const;
+  bool isShown() const;
+  void maybeLoadContent();
+  QQmlContext *componentContext(QQmlComponent *component) const;
+  void setLoadedContent(QQuickItem *item);
+  void setContentLoading(bool loading);
+  void startIncubation();
+  void incubator_finished();
+  void finishIncubation();
+  void cancelIncubation();
+
+  void updateEffectiveVisibility();
+  void setOccluded(bool occluded);
+  void setSuspended(bool suspended);
+  void suspendObject(QObject *object);
+
+  void beginDrag(const QPointF &grabOffset);
+  void drag(const QPointF &globalPos);
+  void setDragPosition(const QPointF &pos, const QPointF &globalPos);
+  void endDrag();
+
+  void updateRenderRate();
+  void rateLayer_refresh();
+
   Q_DECL_DEPRECATED
   bool detachable;
   Q_DECL_DEPRECATED
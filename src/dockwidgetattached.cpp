@@ -0,0 +1,101 @@
+#include "dockwidgetattached.h"
+#include "dockcontainer.h"
+#include "dockwidget.h"
+
+#include <QQmlEngine>
+#include <QQuickItem>
+
+DockWidgetAttached::DockWidgetAttached(QObject *parent)
+    : QObject(parent), _item(qobject_cast<QQuickItem *>(parent)), _resolved(false) {}
+
+DockWidget *DockWidgetAttached::widget() {
+  if (!_resolved)
+    resolve();
+  return _widget;
+}
+
+DockContainer *DockWidgetAttached::container() {
+  auto dw = widget();
+  return dw ? dw->dockContainer() : nullptr;
+}
+
+bool DockWidgetAttached::isActive() {
+  auto dw = widget();
+  return dw && dw->isActive();
+}
+
+DockWidgetAttached *DockWidgetAttached::cacheOf(QQuickItem *item) {
+  return qobject_cast<DockWidgetAttached *>(qmlAttachedPropertiesObject<DockWidget>(item, false));
+}
+
+DockWidget *DockWidgetAttached::findOwner(QQuickItem *item) {
+  if (!item)
+    return nullptr;
+
+  if (auto cache = cacheOf(item))
+    return cache->widget();
+
+  // an ancestor that already knows its dock answers for the items below it,
+  // nothing is attached to the ones passed on the way
+  for (auto p = item; p; p = p->parentItem()) {
+    if (auto owner = qobject_cast<DockWidget *>(p))
+      return owner;
+    auto c = p == item ? nullptr : cacheOf(p);
+    if (c && c->_resolved)
+      return c->_widget;
+  }
+  return nullptr;
+}
+
+void DockWidgetAttached::resolve() {
+  unwatchPath();
+
+  // any item between this one and the dock moving can change the answer
+  DockWidget *owner{nullptr};
+  for (auto p = _item; p; p = p->parentItem()) {
+    owner = qobject_cast<DockWidget *>(p);
+    if (owner)
+      break;
+    _pathConnections.append(connect(p, &QQuickItem::parentChanged, this, &DockWidgetAttached::item_parentChanged));
+  }
+
+  setWidget(owner);
+}
+
+void DockWidgetAttached::unwatchPath() {
+  for (auto &connection : _pathConnections)
+    disconnect(connection);
+  _pathConnections.clear();
+}
+
+void DockWidgetAttached::item_parentChanged() {
+  _resolved = false;
+  unwatchPath();
+
+  // bindings on this item learn about their new dock now, otherwise the
+  // next read resolves again
+  if (receivers(SIGNAL(widgetChanged(DockWidget *))) || receivers(SIGNAL(containerChanged(DockContainer *))) ||
+      receivers(SIGNAL(isActiveChanged(bool))))
+    resolve();
+}
+
+void DockWidgetAttached::setWidget(DockWidget *widget) {
+  _resolved = true;
+  if (_widget == widget)
+    return;
+
+  if (_widget)
+    _widget->disconnect(this);
+
+  _widget = widget;
+
+  if (_widget) {
+    connect(_widget, &DockWidget::dockContainerChanged, this, &DockWidgetAttached::containerChanged);
+    connect(_widget, &DockWidget::isActiveChanged, this, &DockWidgetAttached::isActiveChanged);
+    connect(_widget, &QObject::destroyed, this, [this]() { _resolved = false; });
+  }
+
+  Q_EMIT widgetChanged(_widget);
+  Q_EMIT containerChanged(container());
+  Q_EMIT isActiveChanged(isActive());
+}
@@ -0,0 +1,51 @@
+#ifndef DOCKWIDGETATTACHED_H
+#define DOCKWIDGETATTACHED_H
+
+#include <QObject>
+#include <QPointer>
+
+class QQuickItem;
+class DockContainer;
+class DockWidget;
+
+// Attached to any item as DockWidget.widget / DockWidget.container; the
+// owning dock is resolved once and cached here instead of per lookup. The
+// answer watches parentChanged of the items on its way to the dock, so only
+// the caches below an item that moved are dropped; ancestors get nothing
+// attached to them.
+class DockWidgetAttached : public QObject {
+  Q_OBJECT
+  Q_PROPERTY(DockWidget *widget READ widget NOTIFY widgetChanged)
+  Q_PROPERTY(DockContainer *container READ container NOTIFY containerChanged)
+  Q_PROPERTY(bool isActive READ isActive NOTIFY isActiveChanged)
+
+  QQuickItem *_item;
+  QPointer<DockWidget> _widget;
+  bool _resolved;
+  QList<QMetaObject::Connection> _pathConnections;
+
+public:
+  DockWidgetAttached(QObject *parent);
+
+  DockWidget *widget();
+  DockContainer *container();
+  bool isActive();
+
+  static DockWidget *findOwner(QQuickItem *item);
+
+Q_SIGNALS:
+  void widgetChanged(DockWidget *widget);
+  void containerChanged(DockContainer *container);
+  void isActiveChanged(bool isActive);
+
+private Q_SLOTS:
+  void item_parentChanged();
+
+private:
+  static DockWidgetAttached *cacheOf(QQuickItem *item);
+  void resolve();
+  void unwatchPath();
+  void setWidget(DockWidget *widget);
+};
+
+#endif // DOCKWIDGETATTACHED_H
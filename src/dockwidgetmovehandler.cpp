@@ -42,9 +42,9 @@ void DockWidgetMoveHandler::mouseMoveEvent(QMouseEvent *event) {
   }
   if (_moveEmitted) {
     if (m_dockWidget->getIsDetached())
-      Q_EMIT moving(_lastParentPos + (event->globalPos() - _lastMousePos), event->pos() + m_dockWidget->dockWindow()->position());
+      Q_EMIT moving(_lastParentPos + (event->globalPos() - _lastMousePos), event->globalPos());
     else
-      Q_EMIT moving(_lastParentPos + (event->windowPos() - _lastMousePos), event->pos() + m_dockWidget->position());
+      Q_EMIT moving(_lastParentPos + (event->windowPos() - _lastMousePos), event->globalPos());
   } else {
     Q_EMIT moveStarted();
     _moveEmitted = true;
@@ -27,7 +27,7 @@ public Q_SLOTS:
 Q_SIGNALS:
   void dockWidgetChanged(DockWidget *dockWidget);
   void moveStarted();
-  void moving(const QPointF &windowPos, const QPointF &cursorPos);
+  void moving(const QPointF &windowPos, const QPointF &globalPos);
   void moveEnded();
 
 protected:
@@ -24,14 +24,27 @@ SOURCES += \
     $$PWD/dock.cpp \
     $$PWD/dockarea.cpp \
     $$PWD/dockcontainer.cpp \
+    $$PWD/dockcontentincubator.cpp \
     $$PWD/dockdockableitem.cpp \
+    $$PWD/dockdragsession.cpp \
+    $$PWD/dockdroptargetindex.cpp \
+    $$PWD/dockfloatinglayer.cpp \
+    $$PWD/dockgriphandle.cpp \
+    $$PWD/dockgriplayer.cpp \
     $$PWD/dockgroupresizehandler.cpp \
+    $$PWD/docklayouthistory.cpp \
+    $$PWD/docklayoutjournal.cpp \
+    $$PWD/docklayoutmodel.cpp \
+    $$PWD/docklayoutsnapshot.cpp \
     $$PWD/dockmoveguide.cpp \
     $$PWD/dockplugin.cpp \
+    $$PWD/dockquickopenmodel.cpp \
+    $$PWD/dockrectindex.cpp \
     $$PWD/docktabbar.cpp \
     $$PWD/docktabbararrorbutton.cpp \
     $$PWD/docktabbutton.cpp \
     $$PWD/dockwidget.cpp \
+    $$PWD/dockwidgetattached.cpp \
     $$PWD/dockwidgetbackground.cpp \
     $$PWD/dockwidgetheader.cpp \
     $$PWD/dockwidgetheaderbutton.cpp \
@@ -55,16 +68,29 @@ HEADERS += \
     $$PWD/dockarea_p.h \
     $$PWD/dockcontainer.h \
     $$PWD/dockcontainer_p.h \
+    $$PWD/dockcontentincubator.h \
     $$PWD/dockdockableitem.h \
     $$PWD/dockdockableitem_p.h \
+    $$PWD/dockdragsession.h \
+    $$PWD/dockdroptargetindex.h \
+    $$PWD/dockfloatinglayer.h \
+    $$PWD/dockgriphandle.h \
+    $$PWD/dockgriplayer.h \
     $$PWD/dockgroupresizehandler.h \
+    $$PWD/docklayouthistory.h \
+    $$PWD/docklayoutjournal.h \
+    $$PWD/docklayoutmodel.h \
+    $$PWD/docklayoutsnapshot.h \
     $$PWD/dockmoveguide.h \
     $$PWD/dockplugin.h \
+    $$PWD/dockquickopenmodel.h \
+    $$PWD/dockrectindex.h \
     $$PWD/docktabbar.h \
     $$PWD/docktabbararrorbutton.h \
     $$PWD/docktabbutton.h \
     $$PWD/dockwidget.h \
     $$PWD/dockwidget_p.h \
+    $$PWD/dockwidgetattached.h \
     $$PWD/dockwidgetbackground.h \
     $$PWD/dockwidgetheader.h \
     $$PWD/dockwidgetheaderbutton.h \
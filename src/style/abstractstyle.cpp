@@ -3,8 +3,33 @@
 
 #include <dockcontainer.h>
 
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QQuickWindow>
+#include <QTimer>
+
+#define FRAME_TIME 16
+#define MAX_UPDATES_PER_FRAME 512
+
+namespace {
+QElapsedTimer &frameClock() {
+  static QElapsedTimer clock;
+  if (!clock.isValid())
+    clock.start();
+  return clock;
+}
+} // namespace
+
 AbstractStyle *AbstractStyle::_style{nullptr};
 QList<QQuickItem *> AbstractStyle::_items;
+QHash<QQuickItem *, int> AbstractStyle::_itemIndexes;
+QList<QPointer<QQuickItem>> AbstractStyle::_pendingUpdates;
+int AbstractStyle::_pendingIndex{0};
+int AbstractStyle::_updatesPerFrame{16};
+QPointer<QTimer> AbstractStyle::_updateTimer;
+QMetaObject::Connection AbstractStyle::_frameConnection;
+qint64 AbstractStyle::_batchStart{0};
+int AbstractStyle::_updateBudget{4};
 
 AbstractStyle *AbstractStyle::style() {
   if (Q_UNLIKELY(!_style))
@@ -17,11 +42,108 @@ void AbstractStyle::setStyle(AbstractStyle *style, bool deleteOldStyle) {
     delete _style;
   _style = style;
 
-  for (auto i = _items.begin(); i != _items.end(); ++i)
-    (*i)->update();
+  if (_items.isEmpty())
+    return;
+
+  // Items on screen are repainted first, the rest follow in later frames
+  QList<QPointer<QQuickItem>> hidden;
+  _pendingUpdates.clear();
+  _pendingIndex = 0;
+  for (auto &item : _items) {
+    auto w = item->window();
+    if (item->isVisible() && w && w->isVisible())
+      _pendingUpdates.append(item);
+    else
+      hidden.append(item);
+  }
+  _pendingUpdates.append(hidden);
+
+  if (!_updateTimer) {
+    _updateTimer = new QTimer(QCoreApplication::instance());
+    _updateTimer->setSingleShot(true);
+    QObject::connect(_updateTimer, &QTimer::timeout, &AbstractStyle::updateNextItems);
+  }
+  updateNextItems();
+}
+
+void AbstractStyle::updateNextItems() {
+  QObject::disconnect(_frameConnection);
+  _updateTimer->stop();
+
+  // update() only marks an item dirty, the paint runs in the next frame;
+  // so the batch is a number of items per frame, not a slice of time here
+  QQuickWindow *window{nullptr};
+  auto end = qMin(_pendingUpdates.size(), _pendingIndex + _updatesPerFrame);
+  for (; _pendingIndex < end; ++_pendingIndex) {
+    auto &item = _pendingUpdates.at(_pendingIndex);
+    if (!item)
+      continue;
+    item->update();
+    if (!window && item->window() && item->window()->isExposed())
+      window = item->window();
+  }
+
+  if (_pendingIndex >= _pendingUpdates.size()) {
+    _pendingUpdates.clear();
+    _pendingIndex = 0;
+    return;
+  }
+
+  // the next batch waits for the frame that paints this one; items that are
+  // not on screen do not render, they just continue from the event loop
+  if (window) {
+    _batchStart = frameClock().elapsed();
+    _frameConnection = QObject::connect(window, &QQuickWindow::frameSwapped, window, &AbstractStyle::frameRendered,
+                                        Qt::QueuedConnection);
+    // a window closed meanwhile never swaps again
+    _updateTimer->start(100);
+  } else {
+    _updateTimer->start(0);
+  }
+}
+
+void AbstractStyle::frameRendered() {
+  // a second swap queued before the first was handled
+  if (!_frameConnection)
+    return;
+
+  // frames that overrun the budget halve the batch, fast ones double it
+  auto elapsed = frameClock().elapsed() - _batchStart;
+  if (elapsed > FRAME_TIME + _updateBudget)
+    _updatesPerFrame = qMax(1, _updatesPerFrame / 2);
+  else if (elapsed <= FRAME_TIME)
+    _updatesPerFrame = qMin(MAX_UPDATES_PER_FRAME, _updatesPerFrame * 2);
+  updateNextItems();
 }
 
 void AbstractStyle::registerThemableItem(QQuickItem *item) {
+  if (_itemIndexes.contains(item))
+    return;
+
+  _itemIndexes.insert(item, _items.size());
   _items.append(item);
-  QObject::connect(item, &QObject::destroyed, [item]() { _items.removeOne(item); });
+  QObject::connect(item, &QObject::destroyed, [item]() { unregisterThemableItem(item); });
+}
+
+void AbstractStyle::unregisterThemableItem(QQuickItem *item) {
+  auto i = _itemIndexes.find(item);
+  if (i == _itemIndexes.end())
+    return;
+
+  // Swap the last item into the hole instead of shifting the list
+  auto index = *i;
+  _itemIndexes.erase(i);
+  auto last = _items.takeLast();
+  if (index < _items.size()) {
+    _items[index] = last;
+    _itemIndexes[last] = index;
+  }
+}
+
+int AbstractStyle::updateBudget() {
+  return _updateBudget;
+}
+
+void AbstractStyle::setUpdateBudget(int msecs) {
+  _updateBudget = qMax(1, msecs);
 }
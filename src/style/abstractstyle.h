@@ -4,9 +4,13 @@
 #define dockStyle AbstractStyle::style()
 #include <QtGlobal>
 #include <QFont>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
 #include "dock.h"
 
 class QPainter;
+class QTimer;
 
 class DockContainer;
 class DockTabBar;
@@ -23,6 +27,19 @@ class DockTabBarArrorButton;
 class AbstractStyle {
   static AbstractStyle *_style;
   static QList<QQuickItem *> _items;
+  static QHash<QQuickItem *, int> _itemIndexes;
+  // re-theme queue, drained a batch per rendered frame from _pendingIndex on
+  static QList<QPointer<QQuickItem>> _pendingUpdates;
+  static int _pendingIndex;
+  static int _updatesPerFrame;
+  static QPointer<QTimer> _updateTimer;
+  static QMetaObject::Connection _frameConnection;
+  static qint64 _batchStart;
+  static int _updateBudget;
+
+  static void unregisterThemableItem(QQuickItem *item);
+  static void updateNextItems();
+  static void frameRendered();
 
 public:
   AbstractStyle() = default;
@@ -30,6 +47,10 @@ public:
   static AbstractStyle *style();
   static void setStyle(AbstractStyle *style, bool deleteOldStyle = true);
   static void registerThemableItem(QQuickItem *item);
+  // milliseconds a frame may run over while re-theming before fewer items
+  // are repainted per frame
+  static int updateBudget();
+  static void setUpdateBudget(int msecs);
 
   virtual QFont font() const = 0;
 
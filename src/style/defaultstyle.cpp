@@ -371,14 +371,16 @@ void DefaultStyle::paintResizeHandler(QPainter *p, DockAreaResizeHandler *item,
 }
 
 void DefaultStyle::paintDockArea(QPainter *p, DockArea *item) {
-  Q_UNUSED(p)
-  Q_UNUSED(item)
+  if (item->autoHide() && !item->expanded())
+    return;
+
   if (item->displayType() == Dock::TabbedView && item->widgets().count()) {
+    auto edge = item->effectiveTabPosition();
     QRectF rc;
-    rc.setTop(item->tabPosition() == Qt::TopEdge ? tabBarSize() - 1 : 0);
-    rc.setLeft(item->tabPosition() == Qt::LeftEdge ? tabBarSize() - 1 : 0);
-    rc.setRight(item->width() - (item->tabPosition() == Qt::RightEdge ? tabBarSize() : 1));
-    rc.setBottom(item->height() - (item->tabPosition() == Qt::BottomEdge ? tabBarSize() : 1));
+    rc.setTop(edge == Qt::TopEdge ? tabBarSize() - 1 : 0);
+    rc.setLeft(edge == Qt::LeftEdge ? tabBarSize() - 1 : 0);
+    rc.setRight(item->width() - (edge == Qt::RightEdge ? tabBarSize() : 1));
+    rc.setBottom(item->height() - (edge == Qt::BottomEdge ? tabBarSize() : 1));
 
     switch (item->area()) {
     case Dock::Left:
@@ -0,0 +1,254 @@
+// Compiles a JSON dock layout description into a C++ source file that
+// registers the layout as a ready made DockLayoutSnapshot, so applications
+// do not parse or build their default layout at startup.
+//
+// {
+//   "areas": {
+//     "Left": { "panelSize": 200, "displayType": "TabbedView", "widgets": ["Files", "Outline"] }
+//   },
+//   "widgets": {
+//     "Log": { "area": "Float", "geometry": [100, 100, 320, 200] },
+//     "Help": { "area": "Right", "closed": true }
+//   }
+// }
+
+#include "docklayoutsnapshot.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTextStream>
+
+#include <algorithm>
+
+namespace {
+
+// mirrors Dock::Area and Dock::DockWidgetDisplayType, dock.h needs QtQuick
+const QHash<QString, qint32> areaValues{{"Top", 0x1},  {"Bottom", 0x2},   {"Left", 0x4},   {"Right", 0x8},
+                                        {"Float", 0x10}, {"Detached", 0x20}, {"Center", 0x40}};
+const QHash<QString, qint32> displayTypeValues{
+    {"Hidden", 0}, {"SplitView", 1}, {"TabbedView", 2}, {"StackedView", 3}};
+
+QTextStream err(stderr);
+
+bool fail(const QString &message) {
+  err << "docklayoutc: " << message << Qt::endl;
+  return false;
+}
+
+bool readArea(const QString &name, const QJsonObject &json, DockLayoutSnapshot::Area *area) {
+  if (!areaValues.contains(name) || areaValues.value(name) >= 0x10)
+    return fail(QStringLiteral("\"%1\" is not a dock area").arg(name));
+
+  area->area = areaValues.value(name);
+  area->panelSize = json.value("panelSize").toDouble(-1);
+  if (json.contains("panelSize") && area->panelSize < 0)
+    return fail(QStringLiteral("area %1 has a negative panel size").arg(name));
+  area->autoHide = json.value("autoHide").toBool(false);
+  area->currentIndex = json.value("currentIndex").toInt(-1);
+
+  auto displayType = json.value("displayType").toString(name == "Center" ? "TabbedView" : "SplitView");
+  if (!displayTypeValues.contains(displayType))
+    return fail(QStringLiteral("\"%1\" is not a display type").arg(displayType));
+  area->displayType = displayTypeValues.value(displayType);
+
+  for (const auto &w : json.value("widgets").toArray())
+    area->widgets.append(w.toString());
+  for (const auto &s : json.value("itemSizes").toArray())
+    area->itemSizes.append(s.toDouble());
+
+  if (!area->itemSizes.isEmpty() && area->itemSizes.size() != area->widgets.size())
+    return fail(QStringLiteral("area %1 has %2 item sizes for %3 widgets")
+                    .arg(name)
+                    .arg(area->itemSizes.size())
+                    .arg(area->widgets.size()));
+  return true;
+}
+
+bool readWidget(const QString &id, const QJsonObject &json, DockLayoutSnapshot::Widget *widget) {
+  widget->id = id;
+  widget->closed = json.value("closed").toBool(widget->closed);
+
+  if (json.contains("area")) {
+    auto area = json.value("area").toString();
+    if (!areaValues.contains(area))
+      return fail(QStringLiteral("\"%1\" is not a dock area").arg(area));
+    widget->area = areaValues.value(area);
+  }
+
+  auto geometry = json.value("geometry").toArray();
+  if (geometry.size() == 4)
+    widget->geometry = QRectF(geometry.at(0).toDouble(), geometry.at(1).toDouble(), geometry.at(2).toDouble(),
+                              geometry.at(3).toDouble());
+  else if (!geometry.isEmpty())
+    return fail(QStringLiteral("geometry of %1 needs x, y, width and height").arg(id));
+
+  if (!widget->area)
+    return fail(QStringLiteral("widget %1 has no area").arg(id));
+  return true;
+}
+
+bool readLayout(const QJsonObject &json, DockLayoutSnapshot *snapshot) {
+  auto areas = json.value("areas").toObject();
+  for (auto i = areas.constBegin(); i != areas.constEnd(); ++i) {
+    DockLayoutSnapshot::Area area;
+    if (!readArea(i.key(), i.value().toObject(), &area))
+      return false;
+    snapshot->areas.append(area);
+
+    for (auto &id : area.widgets) {
+      if (snapshot->findWidget(id))
+        return fail(QStringLiteral("widget %1 is listed twice").arg(id));
+      DockLayoutSnapshot::Widget widget;
+      widget.id = id;
+      widget.area = area.area;
+      snapshot->widgets.append(widget);
+    }
+  }
+
+  auto widgets = json.value("widgets").toObject();
+  for (auto i = widgets.constBegin(); i != widgets.constEnd(); ++i) {
+    auto existing = std::find_if(snapshot->widgets.begin(), snapshot->widgets.end(),
+                                 [&i](const DockLayoutSnapshot::Widget &w) { return w.id == i.key(); });
+    if (existing != snapshot->widgets.end()) {
+      if (!readWidget(i.key(), i.value().toObject(), &*existing))
+        return false;
+      continue;
+    }
+
+    DockLayoutSnapshot::Widget widget;
+    if (!readWidget(i.key(), i.value().toObject(), &widget))
+      return false;
+    snapshot->widgets.append(widget);
+  }
+  return true;
+}
+
+QString stringLiteral(const QString &text) {
+  QString escaped;
+  auto ascii = true;
+  for (auto c : text.toUtf8()) {
+    auto u = static_cast<uchar>(c);
+    if (c == '"' || c == '\\') {
+      escaped += QLatin1Char('\\');
+      escaped += QLatin1Char(c);
+    } else if (u >= 0x20 && u < 0x7f) {
+      escaped += QLatin1Char(c);
+    } else {
+      escaped += QStringLiteral("\\%1").arg(u, 3, 8, QChar('0'));
+      ascii = false;
+    }
+  }
+  return ascii ? QStringLiteral("QStringLiteral(\"%1\")").arg(escaped)
+               : QStringLiteral("QString::fromUtf8(\"%1\")").arg(escaped);
+}
+
+QString number(qreal value) {
+  auto text = QString::number(value, 'g', 17);
+  return text.contains('.') || text.contains('e') ? text : text + QStringLiteral(".");
+}
+
+QString generate(const DockLayoutSnapshot &snapshot, const QString &name, const QString &input) {
+  QString code;
+  QTextStream out(&code);
+
+  out << "// Generated by docklayoutc from " << QFileInfo(input).fileName() << ", do not edit.\n\n"
+      << "#include \"docklayoutsnapshot.h\"\n\n"
+      << "namespace {\n\n"
+      << "const DockLayoutSnapshot &layout() {\n"
+      << "  static const DockLayoutSnapshot snapshot = [] {\n"
+      << "    DockLayoutSnapshot s;\n";
+
+  out << "    s.areas = {\n";
+  for (auto &a : snapshot.areas) {
+    QStringList widgets, sizes;
+    for (auto &w : a.widgets)
+      widgets.append(stringLiteral(w));
+    for (auto &s : a.itemSizes)
+      sizes.append(number(s));
+    out << "        {" << a.area << ", " << number(a.panelSize) << ", " << (a.autoHide ? "true" : "false") << ", "
+        << a.displayType << ", " << a.currentIndex << ", {" << widgets.join(", ") << "}, {" << sizes.join(", ")
+        << "}},\n";
+  }
+  out << "    };\n";
+
+  out << "    s.widgets = {\n";
+  for (auto &w : snapshot.widgets) {
+    out << "        {" << stringLiteral(w.id) << ", " << w.area << ", ";
+    if (w.geometry.isNull())
+      out << "QRectF()";
+    else
+      out << "QRectF(" << number(w.geometry.x()) << ", " << number(w.geometry.y()) << ", "
+          << number(w.geometry.width()) << ", " << number(w.geometry.height()) << ")";
+    out << ", " << (w.closed ? "true" : "false") << "},\n";
+  }
+  out << "    };\n";
+
+  out << "    return s;\n"
+      << "  }();\n"
+      << "  return snapshot;\n"
+      << "}\n\n"
+      << "void registerLayout() {\n"
+      << "  DockLayoutSnapshot::registerLayout(" << stringLiteral(name) << ", &layout);\n"
+      << "}\n\n"
+      << "} // namespace\n\n"
+      << "Q_CONSTRUCTOR_FUNCTION(registerLayout)\n";
+
+  return code;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("docklayoutc");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Compiles a JSON dock layout into a C++ layout initializer");
+  parser.addHelpOption();
+  parser.addOption({{"n", "name"}, "Name the layout is registered under.", "name"});
+  parser.addOption({{"o", "output"}, "Generated C++ source file.", "file"});
+  parser.addOption({{"b", "binary"}, "Also write the layout as a binary snapshot.", "file"});
+  parser.addPositionalArgument("input", "JSON layout description.");
+  parser.process(app);
+
+  auto inputs = parser.positionalArguments();
+  if (inputs.size() != 1 || !parser.isSet("name") || !parser.isSet("output"))
+    parser.showHelp(1);
+
+  QFile file(inputs.first());
+  if (!file.open(QIODevice::ReadOnly)) {
+    fail(QStringLiteral("cannot read %1: %2").arg(file.fileName(), file.errorString()));
+    return 1;
+  }
+
+  QJsonParseError error;
+  auto doc = QJsonDocument::fromJson(file.readAll(), &error);
+  if (!doc.isObject()) {
+    fail(QStringLiteral("%1:%2: %3").arg(file.fileName()).arg(error.offset).arg(error.errorString()));
+    return 1;
+  }
+
+  DockLayoutSnapshot snapshot;
+  if (!readLayout(doc.object(), &snapshot))
+    return 1;
+
+  QSaveFile output(parser.value("output"));
+  if (!output.open(QIODevice::WriteOnly)) {
+    fail(QStringLiteral("cannot write %1: %2").arg(output.fileName(), output.errorString()));
+    return 1;
+  }
+  output.write(generate(snapshot, parser.value("name"), file.fileName()).toUtf8());
+  if (!output.commit())
+    return 1;
+
+  if (parser.isSet("binary") && !snapshot.toFile(parser.value("binary")))
+    return 1;
+
+  return 0;
+}